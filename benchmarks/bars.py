@@ -1,8 +1,9 @@
+import csv
 import math
 import os
+from collections import defaultdict
 from textwrap import wrap
 
-import numpy
 from matplotlib import pyplot
 
 
@@ -16,70 +17,57 @@ distribution_names = {
     "push_front": "Push front",
     "push_middle": "Push middle",
     "ascending_sawtooth": "Ascending sawtooth",
+    "ascending_sawtooth_bad": "Ascending sawtooth (bad)",
     "descending_sawtooth": "Descending sawtooth",
+    "descending_sawtooth_bad": "Descending sawtooth (bad)",
     "alternating": "Alternating",
-    "alternating_16_values": "Alternating (16 values)"
+    "alternating_16_values": "Alternating (16 values)",
+    "sparse_inversions": "Sparse inversions",
+    "vergesort_killer": "Vergesort killer"
 }
 
-sort_order = ["heap_sort", "pdq_sort", "quick_sort", "spread_sort", "std_sort", "verge_sort"]
-
+# Reads the CSV files produced by bench.cpp in the profiles directory
 for filename in os.listdir("profiles"):
-    data = {}
-    for line in open(os.path.join("profiles", filename)):
-        size, distribution, algo, *results = line.split()
-        size = int(size)
-        distribution = distribution_names[distribution]
-        results = [int(result) for result in results]
-        if not size in data: data[size] = {}
-        if not distribution in data[size]: data[size][distribution] = {}
-        data[size][distribution][algo] = results
-
-    for size in data:
-        distributions = (
-            "Shuffled",
-            "Shuffled (16 values)",
-            "All equal",
-            "Ascending",
-            "Descending",
-            "Pipe organ",
-            "Push front",
-            "Push middle",
-            "Ascending sawtooth",
-            "Descending sawtooth",
-            "Alternating",
-            "Alternating (16 values)"
-        )
+    # data[(type, size)][distribution][sorter] = (median, stddev)
+    data = defaultdict(lambda: defaultdict(dict))
+    with open(os.path.join("profiles", filename)) as f:
+        for row in csv.DictReader(f):
+            size = int(row["size"])
+            distribution = distribution_names.get(row["distribution"], row["distribution"])
+            data[row["type"], size][distribution][row["sorter"]] = (
+                float(row["median"]), float(row["stddev"])
+            )
 
-        algos = tuple(data[size]["Shuffled"].keys())
-        algos = tuple(sorted(algos, key=lambda a: sort_order.index(a)))
+    for (value_type, size), results in data.items():
+        distributions = [name for name in distribution_names.values() if name in results]
+        algos = sorted(set.intersection(*(set(results[name]) for name in distributions)))
 
         groupnames = distributions
         groupsize = len(algos)
-        groups = [[data[size][distribution][algo] for algo in algos] for distribution in distributions]
         barwidth = 0.6
         spacing = 1
         groupwidth = groupsize * barwidth + spacing
 
-        colors = ["#1f77b4", "#aec7e8", "#ff7f0e", "#ffbb78", "#800080", "#3ADF00", "#800000"]
+        colors = pyplot.get_cmap("tab20").colors
         for i, algo in enumerate(algos):
-            heights = [numpy.median(data[size][distribution][algo]) for distribution in distributions]
-            errors = [numpy.std(data[size][distribution][algo]) for distribution in distributions]
+            heights = [results[distribution][algo][0] for distribution in distributions]
+            errors = [results[distribution][algo][1] for distribution in distributions]
             pyplot.barh([barwidth*i + groupwidth*n for n in range(len(distributions))],
-                        heights, 0.6, color = colors[i], label = algo)
+                        heights, 0.6, xerr=errors, color=colors[i % len(colors)], label=algo)
 
         # Set axes limits and labels.
         groupnames = ['\n'.join(wrap(l, 11)) for l in groupnames]
         pyplot.yticks([barwidth * groupsize/2 + groupwidth*n for n in range(len(groupnames))],
                       groupnames, horizontalalignment='center')
-        pyplot.xlabel("Cycles per element")
+        pyplot.xlabel("Nanoseconds per element")
 
         # Turn off ticks for y-axis.
         pyplot.tick_params(
                axis="y",
                which="both",
-               left="off",
-               right="off",
-               labelleft="on",
+               left=False,
+               right=False,
+               labelleft=True,
                pad=45)
 
         ax = pyplot.gca()
@@ -87,13 +75,14 @@ for filename in os.listdir("profiles"):
         ax.relim()
         ax.autoscale_view()
         pyplot.ylim(pyplot.ylim()[0]+1, pyplot.ylim()[1]-1)
-        pyplot.legend(loc="lower right", fontsize=12)
+        pyplot.legend(loc="lower right", fontsize=8)
 
-        pyplot.title("Sorting $10^{}$ elements".format(round(math.log(size, 10))))
+        pyplot.title("Sorting $10^{{{}}}$ elements of type {}".format(round(math.log(size, 10)), value_type))
 
         figure = pyplot.gcf()
-        figure.set_size_inches(8 * .75, 6 * .75)
-        pyplot.show()
-        pyplot.savefig(os.path.join("plots", os.path.splitext(filename)[0] + ".png"), dpi = 100, bbox_inches="tight")
+        figure.set_size_inches(8 * .75, 6 * .75 * max(1, groupsize / 6))
+        pyplot.savefig(os.path.join("plots", "{}-{}-{}.png".format(
+            os.path.splitext(filename)[0], value_type, size
+        )), dpi = 100, bbox_inches="tight")
 
         pyplot.clf()
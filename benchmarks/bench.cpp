@@ -1,50 +1,318 @@
 #include <algorithm>
-#include <cassert>
+#include <array>
 #include <chrono>
+#include <cmath>
 #include <cstddef>
 #include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
 #include <iostream>
 #include <iterator>
+#include <limits>
 #include <string>
 #include <type_traits>
 #include <utility>
 #include <vector>
+#include <cpp-sort/adapters/small_array_adapter.h>
+#include <cpp-sort/fixed_sorters.h>
 #include <cpp-sort/sorters.h>
 #include "distributions.h"
 
-#ifdef _WIN32
-    #include <intrin.h>
-    #define rdtsc __rdtsc
-#else
-    #ifdef __i586__
-        static __inline__ unsigned long long rdtsc() {
-            unsigned long long int x;
-            __asm__ volatile(".byte 0x0f, 0x31" : "=A" (x));
-            return x;
+////////////////////////////////////////////////////////////
+// Benchmark harness
+//
+// Sorts collections generated by every distribution from
+// distributions.h with every sorter from sorters.h, for
+// several element types and sizes, and prints statistics
+// about the time taken per element in CSV or JSON. The
+// fixed-size sorters are benchmarked on std::array with
+// sizes up to 32. The default sweep goes from 10 to 100M
+// elements and takes a long time, the following options
+// can be used to restrict it:
+//
+//   --types=int,double,string,record
+//   --sorters=pdq_sorter,verge_sorter,...
+//   --distributions=shuffled,ascending,...
+//   --sizes=10,1000,100000000
+//   --repetitions=15 (measured runs per configuration)
+//   --warmup=2 (unmeasured runs per configuration)
+//   --max-time=10 (seconds after which repetitions stop)
+//   --max-memory=8192 (MiB, bigger configurations are skipped)
+//   --quadratic-limit=100000 (max size for O(n²) sorters)
+//   --format=csv|json
+//
+// The results are written to the standard output, while the
+// progress is reported on the standard error.
+//
+
+namespace
+{
+    ////////////////////////////////////////////////////////////
+    // Types to sort
+
+    // Large trivially copyable record, ordered by its key,
+    // used to see how much moving elements around costs
+    struct record
+    {
+        int key;
+        std::array<int, 31> payload;
+
+        friend auto operator<(const record& lhs, const record& rhs)
+            -> bool
+        {
+            return lhs.key < rhs.key;
         }
-    #elif defined(__x86_64__)
-        static __inline__ unsigned long long rdtsc(){
-            unsigned hi, lo;
-            __asm__ __volatile__("rdtsc" : "=a"(lo), "=d"(hi));
-            return ((unsigned long long) lo) | (((unsigned long long) hi) << 32);
+    };
+
+    // The distributions generate integers, the following functions
+    // turn them into other types while preserving their order
+
+    template<typename T>
+    auto make_value(int value)
+        -> T
+    {
+        return static_cast<T>(value);
+    }
+
+    template<>
+    auto make_value<std::string>(int value)
+        -> std::string
+    {
+        // Fixed-width representation of the biased integer, with
+        // a common prefix long enough to defeat the small string
+        // optimization of the common standard libraries
+        char buffer[64];
+        std::snprintf(buffer, sizeof buffer, "cpp-sort-benchmark-%010lu",
+                      static_cast<unsigned long>(static_cast<std::uint32_t>(value) ^ 0x80000000u));
+        return buffer;
+    }
+
+    template<>
+    auto make_value<record>(int value)
+        -> record
+    {
+        record res;
+        res.key = value;
+        res.payload.fill(value);
+        return res;
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Sorters and distributions registries
+
+    template<typename Collection>
+    struct sorter_entry
+    {
+        std::string name;
+        std::function<void(Collection&)> sort;
+        // Size above which the sorter is too slow to be benchmarked
+        std::size_t max_size;
+    };
+
+    template<typename Collection, typename Sorter>
+    auto add_sorter(std::vector<sorter_entry<Collection>>& sorters, const char* name,
+                    Sorter sorter, std::size_t max_size, std::true_type)
+        -> void
+    {
+        sorters.push_back({ name, [sorter](Collection& collection) { sorter(collection); }, max_size });
+    }
+
+    template<typename Collection, typename Sorter>
+    auto add_sorter(std::vector<sorter_entry<Collection>>&, const char*,
+                    Sorter, std::size_t, std::false_type)
+        -> void
+    {
+        // The sorter can't sort such a collection
+    }
+
+    template<typename Collection, typename Sorter>
+    auto add_sorter(std::vector<sorter_entry<Collection>>& sorters, const char* name,
+                    Sorter sorter, std::size_t max_size=std::numeric_limits<std::size_t>::max())
+        -> void
+    {
+        add_sorter(sorters, name, sorter, max_size,
+                   std::integral_constant<bool, cppsort::is_sorter_v<Sorter, Collection&>>{});
+    }
+
+    template<typename T>
+    auto make_sorters(std::size_t quadratic_limit)
+        -> std::vector<sorter_entry<std::vector<T>>>
+    {
+        using T_ = std::vector<T>;
+        std::vector<sorter_entry<T_>> sorters;
+        add_sorter<T_>(sorters, "block_sorter", cppsort::block_sorter<>{});
+        add_sorter<T_>(sorters, "counting_sorter", cppsort::counting_sorter{});
+        add_sorter<T_>(sorters, "default_sorter", cppsort::default_sorter{});
+        add_sorter<T_>(sorters, "drop_merge_sorter", cppsort::drop_merge_sorter{});
+        add_sorter<T_>(sorters, "external_sorter", cppsort::external_sorter<>{});
+        add_sorter<T_>(sorters, "grail_sorter", cppsort::grail_sorter<>{});
+        add_sorter<T_>(sorters, "heap_sorter", cppsort::heap_sorter{});
+        add_sorter<T_>(sorters, "insertion_sorter", cppsort::insertion_sorter{}, quadratic_limit);
+        add_sorter<T_>(sorters, "lsd_radix_sorter", cppsort::lsd_radix_sorter<>{});
+        add_sorter<T_>(sorters, "merge_insertion_sorter", cppsort::merge_insertion_sorter{}, quadratic_limit);
+        add_sorter<T_>(sorters, "merge_sorter", cppsort::merge_sorter{});
+        add_sorter<T_>(sorters, "packed_string_sorter", cppsort::packed_string_sorter{});
+        add_sorter<T_>(sorters, "parallel_merge_sorter", cppsort::parallel_merge_sorter{});
+        add_sorter<T_>(sorters, "parallel_pdq_sorter", cppsort::parallel_pdq_sorter{});
+        add_sorter<T_>(sorters, "parallel_ska_sorter", cppsort::parallel_ska_sorter{});
+        add_sorter<T_>(sorters, "pdq_sorter", cppsort::pdq_sorter{});
+        add_sorter<T_>(sorters, "poplar_sorter", cppsort::poplar_sorter{});
+        add_sorter<T_>(sorters, "quick_merge_sorter", cppsort::quick_merge_sorter{});
+        add_sorter<T_>(sorters, "quick_sorter", cppsort::quick_sorter{});
+        add_sorter<T_>(sorters, "selection_sorter", cppsort::selection_sorter{}, quadratic_limit);
+        add_sorter<T_>(sorters, "ska_sorter", cppsort::ska_sorter{});
+        add_sorter<T_>(sorters, "smooth_sorter", cppsort::smooth_sorter{});
+        add_sorter<T_>(sorters, "spin_sorter", cppsort::spin_sorter{});
+        add_sorter<T_>(sorters, "split_sorter", cppsort::split_sorter{});
+        add_sorter<T_>(sorters, "spread_sorter", cppsort::spread_sorter{});
+        add_sorter<T_>(sorters, "std_sorter", cppsort::std_sorter{});
+        add_sorter<T_>(sorters, "tim_sorter", cppsort::tim_sorter{});
+        add_sorter<T_>(sorters, "verge_sorter", cppsort::verge_sorter{});
+        return sorters;
+    }
+
+    // Sizes of std::array used to benchmark the fixed-size sorters
+    using fixed_sizes = std::index_sequence<2, 3, 4, 5, 6, 8, 12, 16, 24, 32>;
+
+    template<typename T, std::size_t N>
+    auto make_fixed_sorters()
+        -> std::vector<sorter_entry<std::array<T, N>>>
+    {
+        using T_ = std::array<T, N>;
+        std::vector<sorter_entry<T_>> sorters;
+        // low_comparisons_sorter is only specialized for small sizes
+        add_sorter(sorters, "low_comparisons_sorter",
+                   cppsort::small_array_adapter<cppsort::low_comparisons_sorter>{},
+                   N, std::integral_constant<bool, (N < 14)>{});
+        add_sorter<T_>(sorters, "low_moves_sorter",
+                       cppsort::small_array_adapter<cppsort::low_moves_sorter>{});
+        add_sorter<T_>(sorters, "sorting_network_sorter",
+                       cppsort::small_array_adapter<cppsort::sorting_network_sorter>{});
+        return sorters;
+    }
+
+    using distribution_f = void(*)(std::back_insert_iterator<std::vector<int>>, std::size_t);
+
+    struct distribution_entry
+    {
+        std::string name;
+        distribution_f generate;
+        // Some distributions don't make sense for small sizes
+        std::size_t min_size;
+    };
+
+    auto make_distributions()
+        -> std::vector<distribution_entry>
+    {
+        return {
+            { "shuffled",                   shuffled(),                 0       },
+            { "shuffled_16_values",         shuffled_16_values(),       0       },
+            { "all_equal",                  all_equal(),                0       },
+            { "ascending",                  ascending(),                0       },
+            { "descending",                 descending(),               0       },
+            { "pipe_organ",                 pipe_organ(),               0       },
+            { "push_front",                 push_front(),               0       },
+            { "push_middle",                push_middle(),              0       },
+            { "ascending_sawtooth",         ascending_sawtooth(),       2       },
+            { "ascending_sawtooth_bad",     ascending_sawtooth_bad(),   1'000   },
+            { "descending_sawtooth",        descending_sawtooth(),      2       },
+            { "descending_sawtooth_bad",    descending_sawtooth_bad(),  1'000   },
+            { "alternating",                alternating(),              0       },
+            { "alternating_16_values",      alternating_16_values(),    0       },
+            { "sparse_inversions",          sparse_inversions(),        2       },
+            { "vergesort_killer",           vergesort_killer(),         10'000  }
+        };
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Options
+
+    struct options
+    {
+        std::vector<std::string> types = { "int", "double", "string", "record" };
+        std::vector<std::string> sorters;
+        std::vector<std::string> distributions;
+        std::vector<std::size_t> sizes = {
+            10, 100, 1'000, 10'000, 100'000, 1'000'000, 10'000'000, 100'000'000
+        };
+        std::size_t repetitions = 15;
+        std::size_t warmup = 2;
+        double max_time = 10.0;
+        std::size_t max_memory = std::size_t(8192) * 1024 * 1024;
+        std::size_t quadratic_limit = 100'000;
+        std::string format = "csv";
+    };
+
+    auto split(const std::string& str)
+        -> std::vector<std::string>
+    {
+        std::vector<std::string> res;
+        std::size_t begin = 0;
+        while (begin <= str.size()) {
+            auto end = std::min(str.find(',', begin), str.size());
+            if (end > begin) {
+                res.push_back(str.substr(begin, end - begin));
+            }
+            begin = end + 1;
         }
-    #else
-        #error no rdtsc implementation
-    #endif
-#endif
+        return res;
+    }
 
-template<template<typename...> class Collection, typename T>
-using distr_f = void (*)(std::back_insert_iterator<Collection<T>>, std::size_t);
+    auto contains(const std::vector<std::string>& names, const std::string& name)
+        -> bool
+    {
+        return names.empty()
+            || std::find(std::begin(names), std::end(names), name) != std::end(names);
+    }
 
-template<template<typename...> class Collection, typename T>
-using sort_f = void (*)(Collection<T>&);
+    auto parse_options(int argc, char* argv[])
+        -> options
+    {
+        options opts;
+        for (int idx = 1 ; idx < argc ; ++idx) {
+            std::string arg = argv[idx];
+            auto pos = arg.find('=');
+            if (arg.compare(0, 2, "--") != 0 || pos == std::string::npos) {
+                std::cerr << "invalid argument: " << arg << '\n';
+                std::exit(EXIT_FAILURE);
+            }
+            auto name = arg.substr(2, pos - 2);
+            auto value = arg.substr(pos + 1);
 
-// Type of data to sort during the benchmark
-using value_t = int;
+            if (name == "types") {
+                opts.types = split(value);
+            } else if (name == "sorters") {
+                opts.sorters = split(value);
+            } else if (name == "distributions") {
+                opts.distributions = split(value);
+            } else if (name == "sizes") {
+                opts.sizes.clear();
+                for (auto& size: split(value)) {
+                    opts.sizes.push_back(std::stoull(size));
+                }
+            } else if (name == "repetitions") {
+                opts.repetitions = std::max<std::size_t>(std::stoull(value), 1);
+            } else if (name == "warmup") {
+                opts.warmup = std::stoull(value);
+            } else if (name == "max-time") {
+                opts.max_time = std::stod(value);
+            } else if (name == "max-memory") {
+                opts.max_memory = std::stoull(value) * 1024 * 1024;
+            } else if (name == "quadratic-limit") {
+                opts.quadratic_limit = std::stoull(value);
+            } else if (name == "format" && (value == "csv" || value == "json")) {
+                opts.format = value;
+            } else {
+                std::cerr << "invalid argument: " << arg << '\n';
+                std::exit(EXIT_FAILURE);
+            }
+        }
+        return opts;
+    }
 
-int main()
-{
-    using namespace std::chrono_literals;
+    ////////////////////////////////////////////////////////////
+    // Measurements
 
     // Always use a steady clock
     using clock_type = std::conditional_t<
@@ -53,57 +321,250 @@ int main()
         std::chrono::steady_clock
     >;
 
-    std::pair<std::string, distr_f<std::vector, value_t>> distributions[] = {
-        { "shuffled",               shuffled()              },
-        { "shuffled_16_values",     shuffled_16_values()    },
-        { "all_equal",              all_equal()             },
-        { "ascending",              ascending()             },
-        { "descending",             descending()            },
-        { "pipe_organ",             pipe_organ()            },
-        { "push_front",             push_front()            },
-        { "push_middle",            push_middle()           },
-        { "ascending_sawtooth",     ascending_sawtooth()    },
-        { "descending_sawtooth",    descending_sawtooth()   },
-        { "alternating",            alternating()           },
-        { "alternating_16_values",  alternating_16_values() }
+    struct statistics
+    {
+        std::size_t repetitions;
+        double min;
+        double median;
+        double mean;
+        double p99;
+        double stddev;
+        double max;
     };
 
-    std::pair<std::string, sort_f<std::vector, value_t>> sorts[] = {
-        { "heap_sort",      cppsort::heap_sort      },
-        { "pdq_sort",       cppsort::pdq_sort       },
-        { "quick_sort",     cppsort::quick_sort     },
-        { "spread_sort",    cppsort::spread_sort    },
-        { "std_sort",       cppsort::std_sort       },
-        { "verge_sort",     cppsort::verge_sort     }
+    // Computes statistics about nanoseconds per element
+    auto compute_statistics(std::vector<double> samples)
+        -> statistics
+    {
+        std::sort(std::begin(samples), std::end(samples));
+        auto size = samples.size();
+
+        double sum = 0.0;
+        for (auto sample: samples) {
+            sum += sample;
+        }
+        double mean = sum / size;
+
+        double variance = 0.0;
+        for (auto sample: samples) {
+            variance += (sample - mean) * (sample - mean);
+        }
+        if (size > 1) {
+            variance /= size - 1;
+        }
+
+        // Nearest-rank percentiles
+        auto percentile = [&](double pct) {
+            auto rank = static_cast<std::size_t>(std::ceil(pct * size));
+            return samples[std::max<std::size_t>(rank, 1) - 1];
+        };
+
+        return {
+            size,
+            samples.front(),
+            size % 2 ? samples[size / 2] : (samples[size / 2 - 1] + samples[size / 2]) / 2,
+            mean,
+            percentile(0.99),
+            std::sqrt(variance),
+            samples.back()
+        };
+    }
+
+    // Times the sorter on copies of the original collection, small
+    // collections are sorted by batches to get measurable times
+    template<typename Collection>
+    auto measure(const sorter_entry<Collection>& sorter, const Collection& original,
+                 const options& opts)
+        -> statistics
+    {
+        auto size = static_cast<std::size_t>(std::distance(std::begin(original), std::end(original)));
+        auto batch_size = std::max<std::size_t>(1, 100'000 / std::max<std::size_t>(size, 1));
+        std::vector<Collection> batch(batch_size);
+
+        std::vector<double> samples;
+        auto total_start = clock_type::now();
+        for (std::size_t run = 0 ; run < opts.warmup + opts.repetitions ; ++run) {
+            std::fill(std::begin(batch), std::end(batch), original);
+
+            auto start = clock_type::now();
+            for (auto& collection: batch) {
+                sorter.sort(collection);
+            }
+            auto end = clock_type::now();
+
+            // Double benchmark as unit test
+            if (not std::is_sorted(std::begin(batch.front()), std::end(batch.front()))) {
+                std::cerr << "error: " << sorter.name << " failed to sort the collection\n";
+                std::exit(EXIT_FAILURE);
+            }
+
+            if (run >= opts.warmup) {
+                std::chrono::duration<double, std::nano> elapsed = end - start;
+                samples.push_back(elapsed.count() / (batch_size * std::max<std::size_t>(size, 1)));
+            }
+
+            std::chrono::duration<double> total = clock_type::now() - total_start;
+            if (not samples.empty() && total.count() > opts.max_time) {
+                break;
+            }
+        }
+        return compute_statistics(std::move(samples));
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Output
+
+    struct result_printer
+    {
+        std::string format;
+        bool first = true;
+
+        auto begin()
+            -> void
+        {
+            if (format == "csv") {
+                std::cout << "type,distribution,sorter,size,repetitions,"
+                             "min,median,mean,p99,stddev,max\n";
+            } else {
+                std::cout << "{\n  \"unit\": \"ns/element\",\n  \"results\": [";
+            }
+        }
+
+        auto print(const std::string& type, const std::string& distribution,
+                   const std::string& sorter, std::size_t size, const statistics& stats)
+            -> void
+        {
+            if (format == "csv") {
+                std::cout << type << ',' << distribution << ',' << sorter << ','
+                          << size << ',' << stats.repetitions << ','
+                          << stats.min << ',' << stats.median << ',' << stats.mean << ','
+                          << stats.p99 << ',' << stats.stddev << ',' << stats.max << '\n';
+            } else {
+                std::cout << (first ? "\n" : ",\n")
+                          << "    { \"type\": \"" << type << "\""
+                          << ", \"distribution\": \"" << distribution << "\""
+                          << ", \"sorter\": \"" << sorter << "\""
+                          << ", \"size\": " << size
+                          << ", \"repetitions\": " << stats.repetitions
+                          << ", \"min\": " << stats.min
+                          << ", \"median\": " << stats.median
+                          << ", \"mean\": " << stats.mean
+                          << ", \"p99\": " << stats.p99
+                          << ", \"stddev\": " << stats.stddev
+                          << ", \"max\": " << stats.max << " }";
+            }
+            std::cout.flush();
+            first = false;
+        }
+
+        auto end()
+            -> void
+        {
+            if (format == "json") {
+                std::cout << "\n  ]\n}\n";
+            }
+        }
     };
 
-    std::size_t sizes[] = { 1'000'000 };
-
-    for (auto& distribution: distributions) {
-        for (auto& sort: sorts) {
-            for (auto size: sizes) {
-                std::vector<std::uint64_t> cycles;
-
-                auto total_start = clock_type::now();
-                auto total_end = clock_type::now();
-                while (std::chrono::duration_cast<std::chrono::seconds>(total_end - total_start) < 5s) {
-                    std::vector<value_t> collection;
-                    distribution.second(std::back_inserter(collection), size);
-                    std::uint64_t start = rdtsc();
-                    sort.second(collection);
-                    std::uint64_t end = rdtsc();
-                    assert(std::is_sorted(std::begin(collection), std::end(collection)));
-                    cycles.push_back(double(end - start) / size + 0.5);
-                    total_end = clock_type::now();
+    template<typename T>
+    auto run_benchmarks(const std::string& type, const distribution_entry& distribution,
+                        const options& opts, result_printer& printer)
+        -> void
+    {
+        auto sorters = make_sorters<T>(opts.quadratic_limit);
+
+        for (auto size: opts.sizes) {
+            if (size < distribution.min_size) continue;
+            // The original collection and its copy live at the same time
+            if (2 * size * sizeof(T) > opts.max_memory) {
+                std::cerr << "skipped: " << type << ' ' << distribution.name << ' '
+                          << size << " (not enough memory)\n";
+                continue;
+            }
+
+            std::vector<T> original;
+            {
+                std::vector<int> values;
+                values.reserve(size);
+                distribution.generate(std::back_inserter(values), size);
+                original.reserve(size);
+                for (int value: values) {
+                    original.push_back(make_value<T>(value));
                 }
+            }
 
-                std::sort(std::begin(cycles), std::end(cycles));
+            for (auto& sorter: sorters) {
+                if (not contains(opts.sorters, sorter.name)) continue;
+                if (size > sorter.max_size) continue;
 
-                std::cerr << size << ' ' << distribution.first << ' ' << sort.first
-                          << ' ' << cycles[cycles.size() / 2] << '\n';
-                std::cout << size << ' ' << distribution.first << ' ' << sort.first
-                          << ' ' << cycles[cycles.size() / 2] << '\n';
+                std::cerr << type << ' ' << distribution.name << ' '
+                          << sorter.name << ' ' << size << '\n';
+                auto stats = measure(sorter, original, opts);
+                printer.print(type, distribution.name, sorter.name, size, stats);
             }
         }
     }
+
+    template<typename T, std::size_t N>
+    auto run_fixed_benchmarks(const std::string& type, const distribution_entry& distribution,
+                              const options& opts, result_printer& printer)
+        -> void
+    {
+        if (N < distribution.min_size) return;
+
+        std::vector<int> values;
+        values.reserve(N);
+        distribution.generate(std::back_inserter(values), N);
+        std::array<T, N> original;
+        std::transform(std::begin(values), std::end(values), std::begin(original), make_value<T>);
+
+        for (auto& sorter: make_fixed_sorters<T, N>()) {
+            if (not contains(opts.sorters, sorter.name)) continue;
+
+            std::cerr << type << ' ' << distribution.name << ' '
+                      << sorter.name << ' ' << N << '\n';
+            auto stats = measure(sorter, original, opts);
+            printer.print(type, distribution.name, sorter.name, N, stats);
+        }
+    }
+
+    template<typename T, std::size_t... Sizes>
+    auto run_all_benchmarks(const std::string& type, std::index_sequence<Sizes...>,
+                            const options& opts, result_printer& printer)
+        -> void
+    {
+        for (auto& distribution: make_distributions()) {
+            if (not contains(opts.distributions, distribution.name)) continue;
+
+            // Variadic dispatch only works with expressions
+            int dummy[] = {
+                (run_fixed_benchmarks<T, Sizes>(type, distribution, opts, printer), 0)...
+            };
+            (void) dummy;
+            run_benchmarks<T>(type, distribution, opts, printer);
+        }
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    auto opts = parse_options(argc, argv);
+
+    result_printer printer{opts.format};
+    printer.begin();
+    for (auto& type: opts.types) {
+        if (type == "int") {
+            run_all_benchmarks<int>(type, fixed_sizes{}, opts, printer);
+        } else if (type == "double") {
+            run_all_benchmarks<double>(type, fixed_sizes{}, opts, printer);
+        } else if (type == "string") {
+            run_all_benchmarks<std::string>(type, fixed_sizes{}, opts, printer);
+        } else if (type == "record") {
+            run_all_benchmarks<record>(type, fixed_sizes{}, opts, printer);
+        } else {
+            std::cerr << "unknown type: " << type << '\n';
+            return EXIT_FAILURE;
+        }
+    }
+    printer.end();
 }
@@ -1,4 +1,7 @@
+import csv
 import sys
+from collections import defaultdict
+
 import matplotlib.pyplot as plt
 
 
@@ -7,14 +10,14 @@ def fetch_results(fresults):
     results.pop()
     return [int(elem) for elem in results]
 
-    
-if __name__ == '__main__':
+
+def plot_benchmark_output(filename):
     # Name and results of timing functions
     names = []
     values = []
-    
+
     # Fetch the results
-    with open(sys.argv[1]) as f:
+    with open(filename) as f:
         for line in f:
             results = line.split(' ')
             # Get sorter name
@@ -32,3 +35,40 @@ if __name__ == '__main__':
     plt.xlabel('Number of elements to sort')
     plt.ylabel('Execution time (ms)')
     plt.show()
+
+
+def plot_bench_csv(filename, value_type, distribution):
+    # Median time per element of every sorter depending on the size
+    data = defaultdict(list)
+    with open(filename) as f:
+        for row in csv.DictReader(f):
+            if row["type"] == value_type and row["distribution"] == distribution:
+                data[row["sorter"]].append((int(row["size"]), float(row["median"]), float(row["p99"])))
+
+    for sorter, results in sorted(data.items()):
+        results.sort()
+        sizes = [size for size, _, _ in results]
+        medians = [median for _, median, _ in results]
+        p99s = [p99 for _, _, p99 in results]
+        line, = plt.plot(sizes, medians, label=sorter)
+        plt.fill_between(sizes, medians, p99s, color=line.get_color(), alpha=0.15)
+
+    plt.xscale('log')
+    plt.legend(loc='upper left', fontsize=8)
+    plt.title('{} distribution of {}'.format(distribution, value_type))
+    plt.xlabel('Number of elements to sort')
+    plt.ylabel('Nanoseconds per element (median to p99)')
+    plt.show()
+
+
+if __name__ == '__main__':
+    # Usage: plot.py results.txt
+    #        plot.py results.csv [type] [distribution]
+    with open(sys.argv[1]) as f:
+        is_csv = f.readline().startswith('type,distribution,sorter')
+    if is_csv:
+        value_type = sys.argv[2] if len(sys.argv) > 2 else 'int'
+        distribution = sys.argv[3] if len(sys.argv) > 3 else 'shuffled'
+        plot_bench_csv(sys.argv[1], value_type, distribution)
+    else:
+        plot_benchmark_output(sys.argv[1])
@@ -21,6 +21,7 @@ class CppSortConan(ConanFile):
         "cmake/cpp-sort-config.cmake.in"
     ]
     no_copy_source = True
+    settings = "os"
 
     def package(self):
         # Install with CMake
@@ -33,5 +34,10 @@ class CppSortConan(ConanFile):
         # Copy license file
         self.copy("license.txt", dst="licenses")
 
+    def package_info(self):
+        # The parallel sorters rely on std::thread
+        if self.settings.os == "Linux":
+            self.cpp_info.system_libs = ["pthread"]
+
     def package_id(self):
         self.info.header_only()
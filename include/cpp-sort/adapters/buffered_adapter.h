@@ -0,0 +1,143 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef CPPSORT_ADAPTERS_BUFFERED_ADAPTER_H_
+#define CPPSORT_ADAPTERS_BUFFERED_ADAPTER_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <cpp-sort/fwd.h>
+#include <cpp-sort/sorter_facade.h>
+#include <cpp-sort/sorter_traits.h>
+#include <cpp-sort/utility/adapter_storage.h>
+#include <cpp-sort/utility/memory_resource.h>
+#include "../detail/checkers.h"
+
+namespace cppsort
+{
+    ////////////////////////////////////////////////////////////
+    // Adapter
+
+    namespace detail
+    {
+        // Scratch memory owned by a buffered_adapter, copies
+        // of the adapter start with their own empty arena
+        struct buffered_adapter_arena
+        {
+            mutable utility::monotonic_buffer_resource resource;
+
+            buffered_adapter_arena() = default;
+
+            explicit buffered_adapter_arena(std::size_t initial_size):
+                resource(initial_size)
+            {}
+
+            buffered_adapter_arena(const buffered_adapter_arena&) noexcept {}
+
+            auto operator=(const buffered_adapter_arena&) noexcept
+                -> buffered_adapter_arena&
+            {
+                return *this;
+            }
+        };
+
+        // Gives the memory back to the arena at the end of a sort,
+        // even when it ends with an exception
+        struct buffered_adapter_release
+        {
+            utility::monotonic_buffer_resource& resource;
+
+            ~buffered_adapter_release()
+            {
+                resource.release();
+            }
+        };
+
+        template<typename Sorter>
+        struct buffered_adapter_impl:
+            utility::adapter_storage<Sorter>,
+            check_iterator_category<Sorter>,
+            check_is_always_stable<Sorter>
+        {
+            buffered_adapter_arena arena;
+
+            buffered_adapter_impl() = default;
+
+            explicit buffered_adapter_impl(Sorter&& sorter):
+                utility::adapter_storage<Sorter>(std::move(sorter))
+            {}
+
+            buffered_adapter_impl(Sorter&& sorter, std::size_t initial_size):
+                utility::adapter_storage<Sorter>(std::move(sorter)),
+                arena(initial_size)
+            {}
+
+            template<typename... Args>
+            auto operator()(Args&&... args) const
+                -> decltype(this->get()(std::forward<Args>(args)...))
+            {
+                // The arena is released once the buffers
+                // allocated during the sort are destroyed
+                buffered_adapter_release release{arena.resource};
+                utility::scoped_memory_resource scope(&arena.resource);
+                return this->get()(std::forward<Args>(args)...);
+            }
+        };
+    }
+
+    // Owns an arena kept across calls that the adapted sorter uses
+    // for all its temporary allocations: once the arena is big
+    // enough for the collections being sorted, sorting doesn't
+    // allocate anymore; an adapter must not be used by several
+    // threads at once
+    template<typename Sorter>
+    struct buffered_adapter:
+        sorter_facade<detail::buffered_adapter_impl<Sorter>>
+    {
+        buffered_adapter() = default;
+
+        explicit buffered_adapter(Sorter sorter):
+            sorter_facade<detail::buffered_adapter_impl<Sorter>>(std::move(sorter))
+        {}
+
+        // initial_size is the size in bytes of the first block
+        // of memory allocated by the arena
+        buffered_adapter(Sorter sorter, std::size_t initial_size):
+            sorter_facade<detail::buffered_adapter_impl<Sorter>>(std::move(sorter), initial_size)
+        {}
+    };
+
+    ////////////////////////////////////////////////////////////
+    // is_stable specialization
+
+    template<typename Sorter, typename... Args>
+    struct is_stable<buffered_adapter<Sorter>(Args...)>:
+        is_stable<Sorter(Args...)>
+    {};
+}
+
+#endif // CPPSORT_ADAPTERS_BUFFERED_ADAPTER_H_
@@ -34,6 +34,8 @@
 #include <cpp-sort/sorter_facade.h>
 #include <cpp-sort/sorter_traits.h>
 #include <cpp-sort/utility/adapter_storage.h>
+#include <cpp-sort/utility/functional.h>
+#include "../detail/container_aware/flat_sort.h"
 #include "../detail/projection_compare.h"
 #include "../detail/type_traits.h"
 
@@ -120,7 +122,10 @@ namespace cppsort
 
             template<
                 bool Stability = false,
-                typename Iterable
+                typename Iterable,
+                typename = std::enable_if_t<
+                    not detail::is_flat_sortable<Sorter, Iterable>::value
+                >
             >
             auto operator()(Iterable& iterable) const
                 -> std::enable_if_t<
@@ -137,7 +142,10 @@ namespace cppsort
 
             template<
                 bool Stability = false,
-                typename Iterable
+                typename Iterable,
+                typename = std::enable_if_t<
+                    not detail::is_flat_sortable<Sorter, Iterable>::value
+                >
             >
             auto operator()(Iterable& iterable) const
                 -> std::enable_if_t<
@@ -155,7 +163,10 @@ namespace cppsort
             template<
                 bool Stability = false,
                 typename Iterable,
-                typename Compare
+                typename Compare,
+                typename = std::enable_if_t<
+                    not detail::is_flat_sortable<Sorter, Iterable>::value
+                >
             >
             auto operator()(Iterable& iterable, Compare compare) const
                 -> std::enable_if_t<
@@ -173,7 +184,10 @@ namespace cppsort
             template<
                 bool Stability = false,
                 typename Iterable,
-                typename Compare
+                typename Compare,
+                typename = std::enable_if_t<
+                    not detail::is_flat_sortable<Sorter, Iterable>::value
+                >
             >
             auto operator()(Iterable& iterable, Compare compare) const
                 -> std::enable_if_t<
@@ -192,7 +206,10 @@ namespace cppsort
             template<
                 bool Stability = false,
                 typename Iterable,
-                typename Projection
+                typename Projection,
+                typename = std::enable_if_t<
+                    not detail::is_flat_sortable<Sorter, Iterable>::value
+                >
             >
             auto operator()(Iterable& iterable, Projection projection) const
                 -> std::enable_if_t<
@@ -211,7 +228,10 @@ namespace cppsort
             template<
                 bool Stability = false,
                 typename Iterable,
-                typename Projection
+                typename Projection,
+                typename = std::enable_if_t<
+                    not detail::is_flat_sortable<Sorter, Iterable>::value
+                >
             >
             auto operator()(Iterable& iterable, Projection projection) const
                 -> std::enable_if_t<
@@ -232,7 +252,10 @@ namespace cppsort
             template<
                 bool Stability = false,
                 typename Iterable,
-                typename Projection
+                typename Projection,
+                typename = std::enable_if_t<
+                    not detail::is_flat_sortable<Sorter, Iterable>::value
+                >
             >
             auto operator()(Iterable& iterable, Projection projection) const
                 -> std::enable_if_t<
@@ -260,7 +283,10 @@ namespace cppsort
             template<
                 bool Stability = false,
                 typename Iterable,
-                typename Projection
+                typename Projection,
+                typename = std::enable_if_t<
+                    not detail::is_flat_sortable<Sorter, Iterable>::value
+                >
             >
             auto operator()(Iterable& iterable, Projection projection) const
                 -> std::enable_if_t<
@@ -286,7 +312,10 @@ namespace cppsort
                 bool Stability = false,
                 typename Iterable,
                 typename Compare,
-                typename Projection
+                typename Projection,
+                typename = std::enable_if_t<
+                    not detail::is_flat_sortable<Sorter, Iterable>::value
+                >
             >
             auto operator()(Iterable& iterable, Compare compare, Projection projection) const
                 -> std::enable_if_t<
@@ -307,7 +336,10 @@ namespace cppsort
                 bool Stability = false,
                 typename Iterable,
                 typename Compare,
-                typename Projection
+                typename Projection,
+                typename = std::enable_if_t<
+                    not detail::is_flat_sortable<Sorter, Iterable>::value
+                >
             >
             auto operator()(Iterable& iterable, Compare compare, Projection projection) const
                 -> std::enable_if_t<
@@ -335,7 +367,10 @@ namespace cppsort
                 bool Stability = false,
                 typename Iterable,
                 typename Compare,
-                typename Projection
+                typename Projection,
+                typename = std::enable_if_t<
+                    not detail::is_flat_sortable<Sorter, Iterable>::value
+                >
             >
             auto operator()(Iterable& iterable, Compare compare, Projection projection) const
                 -> std::enable_if_t<
@@ -356,6 +391,91 @@ namespace cppsort
                 return cppsort::sort(this->get(), iterable,
                                      std::move(compare), std::move(projection));
             }
+
+            ////////////////////////////////////////////////////////////
+            // std::list and std::forward_list with sorters that need
+            // random-access iterators: sort handles to the nodes in a
+            // contiguous buffer, then relink the nodes in sorted order
+
+            template<
+                bool Stability = false,
+                template<typename...> class List,
+                typename... Args
+            >
+            auto operator()(List<Args...>& iterable) const
+                -> std::enable_if_t<
+                    detail::is_flat_sortable<Sorter, List<Args...>>::value,
+                    conditional_t<
+                        Stability,
+                        cppsort::is_stable<Sorter(List<Args...>&)>,
+                        void
+                    >
+                >
+            {
+                detail::flat_sort(this->get(), iterable, std::less<>{}, utility::identity{});
+            }
+
+            template<
+                bool Stability = false,
+                template<typename...> class List,
+                typename... Args,
+                typename Compare
+            >
+            auto operator()(List<Args...>& iterable, Compare compare) const
+                -> std::enable_if_t<
+                    detail::is_flat_sortable<Sorter, List<Args...>>::value &&
+                    is_projection<utility::identity, List<Args...>, Compare>::value,
+                    conditional_t<
+                        Stability,
+                        cppsort::is_stable<Sorter(List<Args...>&, Compare)>,
+                        void
+                    >
+                >
+            {
+                detail::flat_sort(this->get(), iterable, std::move(compare), utility::identity{});
+            }
+
+            template<
+                bool Stability = false,
+                template<typename...> class List,
+                typename... Args,
+                typename Projection
+            >
+            auto operator()(List<Args...>& iterable, Projection projection) const
+                -> std::enable_if_t<
+                    detail::is_flat_sortable<Sorter, List<Args...>>::value &&
+                    not is_projection<utility::identity, List<Args...>, Projection>::value &&
+                    is_projection<Projection, List<Args...>>::value,
+                    conditional_t<
+                        Stability,
+                        cppsort::is_stable<Sorter(List<Args...>&, Projection)>,
+                        void
+                    >
+                >
+            {
+                detail::flat_sort(this->get(), iterable, std::less<>{}, std::move(projection));
+            }
+
+            template<
+                bool Stability = false,
+                template<typename...> class List,
+                typename... Args,
+                typename Compare,
+                typename Projection
+            >
+            auto operator()(List<Args...>& iterable, Compare compare, Projection projection) const
+                -> std::enable_if_t<
+                    detail::is_flat_sortable<Sorter, List<Args...>>::value &&
+                    is_projection<Projection, List<Args...>, Compare>::value,
+                    conditional_t<
+                        Stability,
+                        cppsort::is_stable<Sorter(List<Args...>&, Compare, Projection)>,
+                        void
+                    >
+                >
+            {
+                detail::flat_sort(this->get(), iterable, std::move(compare), std::move(projection));
+            }
         };
     }
 
@@ -27,19 +27,24 @@
 ////////////////////////////////////////////////////////////
 // Headers
 ////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <iterator>
+#include <limits>
 #include <type_traits>
 #include <utility>
-#include <vector>
 #include <cpp-sort/sorter_facade.h>
 #include <cpp-sort/sorter_traits.h>
 #include <cpp-sort/utility/adapter_storage.h>
 #include <cpp-sort/utility/as_function.h>
 #include <cpp-sort/utility/functional.h>
-#include <cpp-sort/utility/iter_move.h>
+#include "../detail/apply_permutation.h"
 #include "../detail/checkers.h"
-#include "../detail/scope_exit.h"
+#include "../detail/indirect_sort.h"
+#include "../detail/iterator_traits.h"
+#include "../detail/memory.h"
+#include "../detail/type_traits.h"
 
 namespace cppsort
 {
@@ -48,6 +53,43 @@ namespace cppsort
 
     namespace detail
     {
+        ////////////////////////////////////////////////////////////
+        // Whether the adapted sorter can sort what indirect_adapter
+        // feeds it, used to keep the adapter SFINAE-friendly
+
+        template<typename Sorter, typename RandomAccessIterator,
+                 typename Compare, typename Projection,
+                 bool = is_small_trivial_key<projected_t<RandomAccessIterator, Projection>>::value>
+        struct can_sort_indirect:
+            is_invocable<
+                const Sorter&,
+                typename temporary_vector<RandomAccessIterator>::iterator,
+                typename temporary_vector<RandomAccessIterator>::iterator,
+                Compare,
+                indirect_projection<RandomAccessIterator, Projection>
+            >
+        {};
+
+        template<typename Sorter, typename RandomAccessIterator,
+                 typename Compare, typename Projection>
+        struct can_sort_indirect<Sorter, RandomAccessIterator, Compare, Projection, true>
+        {
+            template<typename Index>
+            using key_index_t = key_index<projected_t<RandomAccessIterator, Projection>, Index>;
+
+            template<typename Index>
+            using is_sortable = is_invocable<
+                const Sorter&,
+                typename temporary_vector<key_index_t<Index>>::iterator,
+                typename temporary_vector<key_index_t<Index>>::iterator,
+                Compare,
+                decltype(&key_index_t<Index>::key)
+            >;
+
+            static constexpr bool value = is_sortable<std::uint32_t>::value
+                                       && is_sortable<std::size_t>::value;
+        };
+
         template<typename Sorter>
         struct indirect_adapter_impl:
             utility::adapter_storage<Sorter>,
@@ -63,85 +105,110 @@ namespace cppsort
                 typename RandomAccessIterator,
                 typename Compare = std::less<>,
                 typename Projection = utility::identity,
-                typename = std::enable_if_t<is_projection_iterator_v<
-                    Projection, RandomAccessIterator, Compare
-                >>
+                typename = std::enable_if_t<
+                    is_projection_iterator_v<Projection, RandomAccessIterator, Compare> &&
+                    can_sort_indirect<Sorter, RandomAccessIterator, Compare, Projection>::value
+                >
             >
             auto operator()(RandomAccessIterator first, RandomAccessIterator last,
                             Compare compare={}, Projection projection={}) const
                 -> decltype(auto)
             {
-                using utility::iter_move;
-                auto&& proj = utility::as_function(projection);
+                using key_type = projected_t<RandomAccessIterator, Projection>;
+                return sort_indirect(first, last, std::move(compare), std::move(projection),
+                                     is_small_trivial_key<key_type>{});
+            }
 
-                ////////////////////////////////////////////////////////////
-                // Indirectly sort the iterators
+        private:
 
-                // Copy the iterators in a vector
-                std::vector<RandomAccessIterator> iterators;
-                iterators.reserve(std::distance(first, last));
-                for (RandomAccessIterator it = first ; it != last ; ++it) {
-                    iterators.push_back(it);
+            ////////////////////////////////////////////////////////////
+            // Key/index mode: sort a contiguous array of (key, index)
+            // pairs, 32-bit indices are used whenever they are enough
+
+            template<typename RandomAccessIterator, typename Compare, typename Projection>
+            auto sort_indirect(RandomAccessIterator first, RandomAccessIterator last,
+                               Compare compare, Projection projection,
+                               std::true_type /* small trivial key */) const
+                -> decltype(auto)
+            {
+                auto size = last - first;
+                if (static_cast<std::uintmax_t>(size) <= std::numeric_limits<std::uint32_t>::max()) {
+                    return sort_key_index<std::uint32_t>(first, last, std::move(compare),
+                                                         std::move(projection));
                 }
+                return sort_key_index<std::size_t>(first, last, std::move(compare),
+                                                   std::move(projection));
+            }
 
-#ifndef __cpp_lib_uncaught_exceptions
-                // Sort the iterators on pointed values
-                this->get()(std::begin(iterators), std::end(iterators), std::move(compare),
-                            [&proj](RandomAccessIterator it) -> decltype(auto) {
-                                return proj(*it);
-                            });
-#else
-                // Work around the sorters that return void
-                auto exit_function = make_scope_success([&] {
-#endif
-                    ////////////////////////////////////////////////////////////
-                    // Move the values according the iterator's positions
-
-                    std::vector<bool> sorted(std::distance(first, last), false);
-
-                    // Element where the current cycle starts
-                    RandomAccessIterator start = first;
-
-                    while (start != last) {
-                        // Find the element to put in current's place
-                        RandomAccessIterator current = start;
-                        auto next_pos = std::distance(first, current);
-                        RandomAccessIterator next = iterators[next_pos];
-                        sorted[next_pos] = true;
-
-                        // Process the current cycle
-                        if (next != current) {
-                            auto tmp = iter_move(current);
-                            while (next != start) {
-                                *current = iter_move(next);
-                                current = next;
-                                auto next_pos = std::distance(first, next);
-                                next = iterators[next_pos];
-                                sorted[next_pos] = true;
-                            }
-                            *current = std::move(tmp);
-                        }
+            template<typename Index, typename RandomAccessIterator,
+                     typename Compare, typename Projection>
+            auto sort_key_index(RandomAccessIterator first, RandomAccessIterator last,
+                                Compare compare, Projection projection) const
+                -> decltype(auto)
+            {
+                using key_type = projected_t<RandomAccessIterator, Projection>;
+                using value_type = key_index<key_type, Index>;
+                auto&& proj = utility::as_function(projection);
 
-                        // Find the next cycle
-                        do {
-                            ++start;
-                        } while (start != last && sorted[start - first]);
+                // Copy the keys and their positions in a vector
+                temporary_vector<value_type> keys;
+                keys.reserve(last - first);
+                Index index = 0;
+                for (RandomAccessIterator it = first ; it != last ; ++it) {
+                    keys.push_back(value_type{ proj(*it), index++ });
+                }
 
+                // Sort the keys, then move the values according to the indices
+                return sort_then_permute(
+                    this->get(), keys.begin(), keys.end(),
+                    std::move(compare), &value_type::key,
+                    [first, last, &keys] {
+                        apply_permutation(
+                            first, last, keys.begin(),
+                            [](const value_type& value) { return value.index; },
+                            [](value_type& value, difference_type_t<RandomAccessIterator> pos) {
+                                value.index = static_cast<Index>(pos);
+                            }
+                        );
                     }
-#ifdef __cpp_lib_uncaught_exceptions
-                });
+                );
+            }
+
+            ////////////////////////////////////////////////////////////
+            // Iterator mode: sort iterators to the original elements
 
-                if (first == last || std::next(first) == last) {
-                    exit_function.release();
+            template<typename RandomAccessIterator, typename Compare, typename Projection>
+            auto sort_indirect(RandomAccessIterator first, RandomAccessIterator last,
+                               Compare compare, Projection projection,
+                               std::false_type /* small trivial key */) const
+                -> decltype(auto)
+            {
+                // Copy the iterators in a vector
+                temporary_vector<RandomAccessIterator> iterators;
+                iterators.reserve(last - first);
+                for (RandomAccessIterator it = first ; it != last ; ++it) {
+                    iterators.push_back(it);
                 }
 
-                return this->get()(std::begin(iterators), std::end(iterators), std::move(compare),
-                                   [&proj](RandomAccessIterator it) -> decltype(auto) {
-                                       return proj(*it);
-                                   });
-#endif
+                // Sort the iterators on pointed values, then move the
+                // values according the iterator's positions
+                return sort_then_permute(
+                    this->get(), iterators.begin(), iterators.end(), std::move(compare),
+                    indirect_projection<RandomAccessIterator, Projection>(std::move(projection)),
+                    [first, last, &iterators] {
+                        apply_permutation(
+                            first, last, iterators.begin(),
+                            [first](RandomAccessIterator it) { return it - first; },
+                            [first](RandomAccessIterator& it, difference_type_t<RandomAccessIterator> pos) {
+                                it = first + pos;
+                            }
+                        );
+                    }
+                );
             }
 
+        public:
+
             ////////////////////////////////////////////////////////////
             // Sorter traits
 
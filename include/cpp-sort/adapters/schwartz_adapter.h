@@ -27,8 +27,11 @@
 ////////////////////////////////////////////////////////////
 // Headers
 ////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <iterator>
+#include <limits>
 #include <memory>
 #include <type_traits>
 #include <utility>
@@ -37,11 +40,13 @@
 #include <cpp-sort/sorter_traits.h>
 #include <cpp-sort/utility/adapter_storage.h>
 #include <cpp-sort/utility/as_function.h>
+#include "../detail/apply_permutation.h"
 #include "../detail/associate_iterator.h"
 #include "../detail/checkers.h"
 #include "../detail/iterator_traits.h"
 #include "../detail/memory.h"
 #include "../detail/type_traits.h"
+#include "../detail/zip_iterator.h"
 
 namespace cppsort
 {
@@ -58,6 +63,58 @@ namespace cppsort
             }
         };
 
+        ////////////////////////////////////////////////////////////
+        // Structure-of-arrays mode: when the adapted sorter is a radix
+        // sorter, the projected keys and their original positions are
+        // stored in two separate arrays so that the passes over the
+        // keys don't have to load anything else
+
+        // Stand-in comparison used to tell radix sorters, which only
+        // accept a few standard comparisons, from comparison sorters
+        struct opaque_compare
+        {
+            template<typename T, typename U>
+            auto operator()(const T& lhs, const U& rhs) const
+                -> bool
+            {
+                return std::less<>{}(lhs, rhs);
+            }
+        };
+
+        template<typename Key, typename Index>
+        using schwartz_soa_iterator = zip_iterator<
+            typename temporary_vector<Key>::iterator,
+            typename temporary_vector<Index>::iterator
+        >;
+
+        template<typename Sorter, typename Key, typename Compare>
+        struct is_radix_sorter_for:
+            conjunction<
+                negation<is_comparison_sorter_iterator<Sorter, Key*, opaque_compare>>,
+                is_comparison_projection_sorter_iterator<
+                    Sorter, schwartz_soa_iterator<Key, std::uint32_t>, Compare, zip_get<0>
+                >,
+                is_comparison_projection_sorter_iterator<
+                    Sorter, schwartz_soa_iterator<Key, std::size_t>, Compare, zip_get<0>
+                >
+            >
+        {};
+
+        template<typename Sorter, typename ForwardIterator, typename Compare, typename Projection>
+        struct use_schwartz_soa:
+            conjunction<
+                std::is_base_of<
+                    std::random_access_iterator_tag,
+                    iterator_category_t<ForwardIterator>
+                >,
+                disjunction<
+                    std::is_same<Compare, std::less<>>,
+                    std::is_same<Compare, std::greater<>>
+                >,
+                is_radix_sorter_for<Sorter, projected_t<ForwardIterator, Projection>, Compare>
+            >
+        {};
+
         ////////////////////////////////////////////////////////////
         // Adapter
 
@@ -90,6 +147,40 @@ namespace cppsort
                 static_assert(not std::is_same<Sorter, stable_adapter<std_sorter>>::value,
                               "stable_adapter<std_sorter> doesn't work with schwartz_adapter");
 
+                return sort_projected(std::move(first), std::move(last),
+                                      std::move(compare), std::move(projection),
+                                      use_schwartz_soa<Sorter, ForwardIterator, Compare, Projection>{});
+            }
+
+            template<typename ForwardIterator, typename Compare=std::less<>>
+            auto operator()(ForwardIterator first, ForwardIterator last,
+                            Compare compare={}) const
+                -> std::enable_if_t<
+                    not is_projection_iterator_v<Compare, ForwardIterator>,
+                    decltype(Sorter{}(std::move(first), std::move(last), std::move(compare)))
+                >
+            {
+                // No projection to handle, forward everything to the adapted sorter
+                return this->get()(std::move(first), std::move(last), std::move(compare));
+            }
+
+            template<typename ForwardIterator, typename Compare>
+            auto operator()(ForwardIterator first, ForwardIterator last,
+                            Compare compare, utility::identity projection) const
+                -> decltype(Sorter{}(std::move(first), std::move(last), std::move(compare), projection))
+            {
+                // utility::identity does nothing, bypass schartz_adapter entirely
+                return this->get()(std::move(first), std::move(last), std::move(compare), projection);
+            }
+
+        private:
+
+            template<typename ForwardIterator, typename Compare, typename Projection>
+            auto sort_projected(ForwardIterator first, ForwardIterator last,
+                                Compare compare, Projection projection,
+                                std::false_type /* structure of arrays */) const
+                -> decltype(auto)
+            {
                 auto&& proj = utility::as_function(projection);
                 using proj_t = projected_t<ForwardIterator, Projection>;
                 using value_t = association<ForwardIterator, proj_t>;
@@ -97,7 +188,7 @@ namespace cppsort
                 // Collection of projected elements
                 auto size = std::distance(first, last);
                 std::unique_ptr<value_t, operator_deleter> projected(
-                    static_cast<value_t*>(::operator new(size * sizeof(value_t))),
+                    allocate_buffer<value_t>(size),
                     operator_deleter(size * sizeof(value_t))
                 );
                 destruct_n<value_t> d(0);
@@ -117,25 +208,59 @@ namespace cppsort
                 );
             }
 
-            template<typename ForwardIterator, typename Compare=std::less<>>
-            auto operator()(ForwardIterator first, ForwardIterator last,
-                            Compare compare={}) const
-                -> std::enable_if_t<
-                    not is_projection_iterator_v<Compare, ForwardIterator>,
-                    decltype(Sorter{}(std::move(first), std::move(last), std::move(compare)))
-                >
+            template<typename RandomAccessIterator, typename Compare, typename Projection>
+            auto sort_projected(RandomAccessIterator first, RandomAccessIterator last,
+                                Compare compare, Projection projection,
+                                std::true_type /* structure of arrays */) const
+                -> decltype(auto)
             {
-                // No projection to handle, forward everything to the adapted sorter
-                return this->get()(std::move(first), std::move(last), std::move(compare));
+                auto size = last - first;
+                if (static_cast<std::uintmax_t>(size) <= std::numeric_limits<std::uint32_t>::max()) {
+                    return sort_soa<std::uint32_t>(first, last, std::move(compare),
+                                                   std::move(projection));
+                }
+                return sort_soa<std::size_t>(first, last, std::move(compare),
+                                             std::move(projection));
             }
 
-            template<typename ForwardIterator, typename Compare>
-            auto operator()(ForwardIterator first, ForwardIterator last,
-                            Compare compare, utility::identity projection) const
-                -> decltype(Sorter{}(std::move(first), std::move(last), std::move(compare), projection))
+            template<typename Index, typename RandomAccessIterator,
+                     typename Compare, typename Projection>
+            auto sort_soa(RandomAccessIterator first, RandomAccessIterator last,
+                          Compare compare, Projection projection) const
+                -> decltype(auto)
             {
-                // utility::identity does nothing, bypass schartz_adapter entirely
-                return this->get()(std::move(first), std::move(last), std::move(compare), projection);
+                auto&& proj = utility::as_function(projection);
+                using proj_t = projected_t<RandomAccessIterator, Projection>;
+
+                // Project the keys once and remember where they come from
+                auto size = last - first;
+                temporary_vector<proj_t> keys;
+                keys.reserve(size);
+                temporary_vector<Index> positions;
+                positions.reserve(size);
+                Index index = 0;
+                for (RandomAccessIterator it = first ; it != last ; ++it) {
+                    keys.push_back(proj(*it));
+                    positions.push_back(index++);
+                }
+
+                // Sort the keys and positions together, then move the
+                // original elements to their final positions
+                return sort_then_permute(
+                    this->get(),
+                    make_zip_iterator(keys.begin(), positions.begin()),
+                    make_zip_iterator(keys.end(), positions.end()),
+                    std::move(compare), zip_get<0>{},
+                    [first, last, &positions] {
+                        apply_permutation(
+                            first, last, positions.begin(),
+                            [](Index pos) { return pos; },
+                            [](Index& pos, difference_type_t<RandomAccessIterator> new_pos) {
+                                pos = static_cast<Index>(new_pos);
+                            }
+                        );
+                    }
+                );
             }
         };
     }
@@ -139,7 +139,7 @@ namespace cppsort
 
                 auto size = std::distance(first, last);
                 std::unique_ptr<value_t, operator_deleter> iterators(
-                    static_cast<value_t*>(::operator new(size * sizeof(value_t))),
+                    allocate_buffer<value_t>(size),
                     operator_deleter(size * sizeof(value_t))
                 );
                 destruct_n<value_t> d(0);
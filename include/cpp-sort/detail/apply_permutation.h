@@ -0,0 +1,99 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef CPPSORT_DETAIL_APPLY_PERMUTATION_H_
+#define CPPSORT_DETAIL_APPLY_PERMUTATION_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <iterator>
+#include <utility>
+#include <cpp-sort/utility/iter_move.h>
+#include "iterator_traits.h"
+#include "scope_exit.h"
+
+namespace cppsort
+{
+namespace detail
+{
+    ////////////////////////////////////////////////////////////
+    // Move the elements of [first, last) according to perm, where
+    // position(perm[i]) is the original position of the element
+    // that must end up at position i; the visited entries are
+    // reset to their own position with reset(perm[i], i) so that
+    // the cycles don't need a separate array of flags
+
+    template<typename RandomAccessIterator, typename PermutationIterator,
+             typename Position, typename Reset>
+    auto apply_permutation(RandomAccessIterator first, RandomAccessIterator last,
+                           PermutationIterator perm, Position position, Reset reset)
+        -> void
+    {
+        using utility::iter_move;
+        using difference_type = difference_type_t<RandomAccessIterator>;
+
+        difference_type size = last - first;
+        for (difference_type start = 0 ; start < size ; ++start) {
+            difference_type next = position(perm[start]);
+            if (next == start) continue;
+
+            // Process the current cycle
+            auto tmp = iter_move(first + start);
+            difference_type current = start;
+            do {
+                first[current] = iter_move(first + next);
+                reset(perm[current], current);
+                current = next;
+                next = position(perm[current]);
+            } while (next != start);
+            first[current] = std::move(tmp);
+            reset(perm[current], current);
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Sort [first, last) then call permute() if the sorter didn't
+    // throw, returning whatever the sorter returns when possible
+
+    template<typename Sorter, typename RandomAccessIterator,
+             typename Compare, typename Projection, typename Permute>
+    auto sort_then_permute(Sorter&& sorter, RandomAccessIterator first, RandomAccessIterator last,
+                           Compare compare, Projection projection, Permute permute)
+        -> decltype(auto)
+    {
+#ifndef __cpp_lib_uncaught_exceptions
+        std::forward<Sorter>(sorter)(first, last, std::move(compare), std::move(projection));
+        permute();
+#else
+        // Work around the sorters that return void
+        auto exit_function = make_scope_success(std::move(permute));
+        if (first == last || std::next(first) == last) {
+            exit_function.release();
+        }
+        return std::forward<Sorter>(sorter)(first, last, std::move(compare), std::move(projection));
+#endif
+    }
+}}
+
+#endif // CPPSORT_DETAIL_APPLY_PERMUTATION_H_
@@ -0,0 +1,220 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef CPPSORT_DETAIL_CONTAINER_AWARE_FLAT_SORT_H_
+#define CPPSORT_DETAIL_CONTAINER_AWARE_FLAT_SORT_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <forward_list>
+#include <iterator>
+#include <list>
+#include <type_traits>
+#include <utility>
+#include <cpp-sort/sorter_traits.h>
+#include <cpp-sort/utility/as_function.h>
+#include "../indirect_sort.h"
+#include "../iterator_traits.h"
+#include "../memory.h"
+
+namespace cppsort
+{
+namespace detail
+{
+    //
+    // Sorting the nodes of a list one by one is cache-unfriendly,
+    // and sorters that need random-access iterators can't sort
+    // lists at all; these algorithms gather handles to the nodes
+    // in a contiguous array, sort that array with the given sorter
+    // and relink the nodes in a single pass
+    //
+    // The nodes are never copied nor moved, only relinked: the
+    // iterators to the elements of the list remain valid
+    //
+
+    template<typename Sorter, typename List>
+    struct is_flat_sortable:
+        std::false_type
+    {};
+
+    template<typename Sorter, typename... Args>
+    struct is_flat_sortable<Sorter, std::list<Args...>>:
+        std::is_base_of<std::random_access_iterator_tag, iterator_category<Sorter>>
+    {};
+
+    template<typename Sorter, typename... Args>
+    struct is_flat_sortable<Sorter, std::forward_list<Args...>>:
+        std::is_base_of<std::random_access_iterator_tag, iterator_category<Sorter>>
+    {};
+
+    ////////////////////////////////////////////////////////////
+    // std::list: iterators to the nodes are sorted, then every
+    // node is spliced at the end of the list in sorted order
+
+    template<typename Sorter, typename Compare, typename Projection, typename... Args>
+    auto list_flat_sort(const Sorter& sorter, std::list<Args...>& collection,
+                        Compare compare, Projection projection,
+                        std::true_type /* small trivial key */)
+        -> void
+    {
+        using iterator = typename std::list<Args...>::iterator;
+        using value_type = key_index<projected_t<iterator, Projection>, iterator>;
+        auto&& proj = utility::as_function(projection);
+
+        temporary_vector<value_type> nodes;
+        nodes.reserve(collection.size());
+        for (auto it = collection.begin() ; it != collection.end() ; ++it) {
+            nodes.push_back(value_type{ proj(*it), it });
+        }
+        sorter(nodes.begin(), nodes.end(), std::move(compare), &value_type::key);
+
+        for (auto& node: nodes) {
+            collection.splice(collection.end(), collection, node.index);
+        }
+    }
+
+    template<typename Sorter, typename Compare, typename Projection, typename... Args>
+    auto list_flat_sort(const Sorter& sorter, std::list<Args...>& collection,
+                        Compare compare, Projection projection,
+                        std::false_type /* small trivial key */)
+        -> void
+    {
+        using iterator = typename std::list<Args...>::iterator;
+
+        temporary_vector<iterator> nodes;
+        nodes.reserve(collection.size());
+        for (auto it = collection.begin() ; it != collection.end() ; ++it) {
+            nodes.push_back(it);
+        }
+        sorter(nodes.begin(), nodes.end(), std::move(compare),
+               indirect_projection<iterator, Projection>(std::move(projection)));
+
+        for (auto it: nodes) {
+            collection.splice(collection.end(), collection, it);
+        }
+    }
+
+    template<typename Sorter, typename Compare, typename Projection, typename... Args>
+    auto flat_sort(const Sorter& sorter, std::list<Args...>& collection,
+                   Compare compare, Projection projection)
+        -> void
+    {
+        using key_type = projected_t<typename std::list<Args...>::iterator, Projection>;
+        list_flat_sort(sorter, collection, std::move(compare), std::move(projection),
+                       is_small_trivial_key<key_type>{});
+    }
+
+    ////////////////////////////////////////////////////////////
+    // std::forward_list: a node can only be unlinked knowing the
+    // node that precedes it, so the nodes are first detached from
+    // the front of the list into single-node lists, indices to
+    // which are sorted; the single-node lists are then spliced
+    // back in sorted order
+
+    template<typename Sorter, typename Compare, typename Projection,
+             typename List, typename Relink>
+    auto flist_sort_nodes(const Sorter& sorter, temporary_vector<List>& nodes,
+                          Compare compare, Projection projection, Relink relink,
+                          std::true_type /* small trivial key */)
+        -> void
+    {
+        using value_type = key_index<projected_t<typename List::iterator, Projection>, std::size_t>;
+        auto&& proj = utility::as_function(projection);
+
+        temporary_vector<value_type> indices;
+        indices.reserve(nodes.size());
+        for (std::size_t index = 0 ; index < nodes.size() ; ++index) {
+            indices.push_back(value_type{ proj(nodes[index].front()), index });
+        }
+        sorter(indices.begin(), indices.end(), std::move(compare), &value_type::key);
+
+        for (auto& index: indices) {
+            relink(index.index);
+        }
+    }
+
+    template<typename Sorter, typename Compare, typename Projection,
+             typename List, typename Relink>
+    auto flist_sort_nodes(const Sorter& sorter, temporary_vector<List>& nodes,
+                          Compare compare, Projection projection, Relink relink,
+                          std::false_type /* small trivial key */)
+        -> void
+    {
+        auto&& proj = utility::as_function(projection);
+
+        temporary_vector<std::size_t> indices;
+        indices.reserve(nodes.size());
+        for (std::size_t index = 0 ; index < nodes.size() ; ++index) {
+            indices.push_back(index);
+        }
+        sorter(indices.begin(), indices.end(), std::move(compare),
+               [&](std::size_t index) -> decltype(auto) {
+                   return proj(nodes[index].front());
+               });
+
+        for (auto index: indices) {
+            relink(index);
+        }
+    }
+
+    template<typename Sorter, typename Compare, typename Projection, typename... Args>
+    auto flat_sort(const Sorter& sorter, std::forward_list<Args...>& collection,
+                   Compare compare, Projection projection)
+        -> void
+    {
+        using list_type = std::forward_list<Args...>;
+        using key_type = projected_t<typename list_type::iterator, Projection>;
+
+        temporary_vector<list_type> nodes;
+        nodes.reserve(std::distance(collection.begin(), collection.end()));
+
+        auto tail = collection.before_begin();
+        auto relink = [&](std::size_t index) {
+            auto& node = nodes[index];
+            if (node.empty()) return;
+            collection.splice_after(tail, node);
+            ++tail;
+        };
+
+        try {
+            while (not collection.empty()) {
+                nodes.emplace_back(collection.get_allocator());
+                nodes.back().splice_after(nodes.back().before_begin(),
+                                          collection, collection.before_begin());
+            }
+            flist_sort_nodes(sorter, nodes, std::move(compare), std::move(projection),
+                             relink, is_small_trivial_key<key_type>{});
+        } catch (...) {
+            // Give the nodes back to the list in their original
+            // order, skipping the ones already relinked
+            for (std::size_t index = 0 ; index < nodes.size() ; ++index) {
+                relink(index);
+            }
+            throw;
+        }
+    }
+}}
+
+#endif // CPPSORT_DETAIL_CONTAINER_AWARE_FLAT_SORT_H_
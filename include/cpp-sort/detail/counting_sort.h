@@ -28,61 +28,308 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <algorithm>
+#include <cstddef>
 #include <functional>
 #include <iterator>
-#include <vector>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <cpp-sort/utility/as_function.h>
+#include <cpp-sort/utility/functional.h>
+#include <cpp-sort/utility/iter_move.h>
 #include "iterator_traits.h"
+#include "memory.h"
 #include "minmax_element_and_is_sorted.h"
+#include "quick_merge_sort.h"
+#include "reverse.h"
+#include "ska_sort.h"
+#include "task_pool.h"
+#include "type_traits.h"
 
 namespace cppsort
 {
 namespace detail
 {
-    template<typename ForwardIterator>
-    auto counting_sort(ForwardIterator first, ForwardIterator last)
-        -> void
+    namespace counting_sort_detail
     {
-        auto info = minmax_element_and_is_sorted(first, last);
-        if (info.is_sorted) return;
+        enum {
+            // Key ranges up to this size are always counted,
+            // whatever the size of the collection to sort
+            min_range_limit = 1 << 16,
 
-        using difference_type = difference_type_t<ForwardIterator>;
-        auto min = *info.min;
-        auto max = *info.max;
-        std::vector<difference_type> counts(max - min + 1, 0);
+            // Collections are not split into chunks smaller than
+            // this to compute the histograms in parallel
+            min_chunk_size = 1 << 18
+        };
 
-        for (auto it = first ; it != last ; ++it)
+        // Whether it is worth allocating counters for every key in
+        // [min, max] to sort size elements; the difference is computed
+        // with unsigned arithmetic to avoid signed integer overflows
+        template<typename Integer>
+        auto is_range_small_enough(Integer min, Integer max, std::size_t size)
+            -> bool
         {
-            ++counts[*it - min];
+            using unsigned_t = make_unsigned_t<Integer>;
+            using common_t = std::common_type_t<unsigned_t, std::size_t>;
+            auto diff = static_cast<unsigned_t>(static_cast<unsigned_t>(max) - static_cast<unsigned_t>(min));
+            auto limit = std::max<std::size_t>(2 * size, min_range_limit);
+            return static_cast<common_t>(diff) < static_cast<common_t>(limit);
         }
 
-        for (auto count: counts)
+        template<typename Integer>
+        auto counter_index(Integer key, Integer min)
+            -> std::size_t
         {
-            first = std::fill_n(first, count, min++);
+            using unsigned_t = make_unsigned_t<Integer>;
+            return static_cast<std::size_t>(
+                static_cast<unsigned_t>(static_cast<unsigned_t>(key) - static_cast<unsigned_t>(min))
+            );
         }
-    }
 
-    template<typename ForwardIterator>
-    auto reverse_counting_sort(ForwardIterator first, ForwardIterator last)
-        -> void
-    {
-        auto info = minmax_element_and_is_sorted(first, last, std::greater<>{});
-        if (info.is_sorted) return;
+        // Every task needs its own counters, so the histograms are only
+        // computed in parallel when there are many more elements than
+        // counters, and only with random-access iterators
+        template<typename ForwardIterator>
+        auto tasks_count(std::size_t, std::size_t, ForwardIterator, ForwardIterator,
+                         std::forward_iterator_tag)
+            -> std::size_t
+        {
+            return 1;
+        }
+
+        template<typename RandomAccessIterator>
+        auto tasks_count(std::size_t size, std::size_t range,
+                         RandomAccessIterator, RandomAccessIterator,
+                         std::random_access_iterator_tag)
+            -> std::size_t
+        {
+            return parallel_threads_count(0, std::min(size / min_chunk_size, size / range));
+        }
+
+        // Calls function(chunk_first, chunk_last, task, offset) for every
+        // chunk [first + offset, chunk_last) of the nb_tasks chunks of
+        // the collection, in parallel when there is more than one
+        template<typename ForwardIterator, typename Function>
+        auto for_each_chunk(ForwardIterator first, ForwardIterator last, std::size_t size,
+                            std::size_t nb_tasks, Function function)
+            -> void
+        {
+            if (nb_tasks == 1) {
+                function(std::move(first), std::move(last), 0, 0);
+                return;
+            }
+
+            using difference_type = difference_type_t<ForwardIterator>;
+            auto& pool = task_pool::shared(nb_tasks - 1);
+            task_group group(pool);
+            for (std::size_t task = 0 ; task < nb_tasks ; ++task) {
+                group.run([&, task] {
+                    std::size_t begin = task * size / nb_tasks;
+                    std::size_t end = (task + 1) * size / nb_tasks;
+                    function(std::next(first, static_cast<difference_type>(begin)),
+                             std::next(first, static_cast<difference_type>(end)),
+                             task, begin);
+                });
+            }
+            group.wait();
+        }
+
+        // Counts the keys of every chunk in its own histogram, the
+        // histogram of a given task starts at counts[task * range]
+        template<typename ForwardIterator, typename Integer, typename Projection>
+        auto make_histograms(ForwardIterator first, ForwardIterator last, std::size_t size,
+                             Integer min, std::size_t range, std::size_t nb_tasks,
+                             Projection projection)
+            -> temporary_vector<std::size_t>
+        {
+            auto&& proj = utility::as_function(projection);
+
+            temporary_vector<std::size_t> counts(nb_tasks * range, 0);
+            for_each_chunk(first, last, size, nb_tasks,
+                           [&](auto chunk_first, auto chunk_last, std::size_t task, std::size_t) {
+                auto task_counts = counts.data() + task * range;
+                for (; chunk_first != chunk_last ; ++chunk_first) {
+                    ++task_counts[counter_index(proj(*chunk_first), min)];
+                }
+            });
+            return counts;
+        }
 
-        using difference_type = difference_type_t<ForwardIterator>;
-        auto min = *info.max;
-        auto max = *info.min;
-        std::vector<difference_type> counts(max - min + 1, 0);
+        // Used when the range of keys is too big for a counting sort
+        template<typename ForwardIterator, typename Compare, typename Projection>
+        auto fallback_sort(ForwardIterator first, ForwardIterator last, std::size_t size,
+                           Compare compare, Projection projection,
+                           std::forward_iterator_tag)
+            -> void
+        {
+            quick_merge_sort(std::move(first), std::move(last),
+                             static_cast<difference_type_t<ForwardIterator>>(size),
+                             std::move(compare), std::move(projection));
+        }
 
-        for (auto it = first ; it != last ; ++it)
+        template<typename RandomAccessIterator, typename Compare, typename Projection>
+        auto fallback_sort(RandomAccessIterator first, RandomAccessIterator last, std::size_t,
+                           Compare, Projection projection,
+                           std::random_access_iterator_tag)
+            -> void
         {
-            ++counts[*it - min];
+            ska_sort(first, last, std::move(projection));
+            if (std::is_same<Compare, std::greater<>>::value) {
+                detail::reverse(std::move(first), std::move(last));
+            }
         }
 
-        for (auto rit = std::rbegin(counts) ; rit != std::rend(counts) ; ++rit)
+        ////////////////////////////////////////////////////////////
+        // Counting sort of integers: the collection is rewritten
+        // from the histogram
+
+        template<typename ForwardIterator, typename Compare>
+        auto counting_sort_values(ForwardIterator first, ForwardIterator last, Compare compare)
+            -> void
         {
-            auto count = *rit;
-            first = std::fill_n(first, count, max--);
+            constexpr bool descending = std::is_same<Compare, std::greater<>>::value;
+
+            auto info = minmax_element_and_is_sorted(first, last, compare);
+            if (info.is_sorted) return;
+
+            auto min = descending ? *info.max : *info.min;
+            auto max = descending ? *info.min : *info.max;
+            auto size = static_cast<std::size_t>(std::distance(first, last));
+            if (not is_range_small_enough(min, max, size)) {
+                fallback_sort(std::move(first), std::move(last), size,
+                              std::move(compare), utility::identity{},
+                              iterator_category_t<ForwardIterator>{});
+                return;
+            }
+
+            std::size_t range = counter_index(max, min) + 1;
+            std::size_t nb_tasks = tasks_count(size, range, first, last,
+                                               iterator_category_t<ForwardIterator>{});
+            auto counts = make_histograms(first, last, size, min, range, nb_tasks,
+                                          utility::identity{});
+
+            auto value = descending ? max : min;
+            for (std::size_t i = 0 ; i < range ; ++i) {
+                std::size_t key = descending ? range - 1 - i : i;
+                std::size_t count = 0;
+                for (std::size_t task = 0 ; task < nb_tasks ; ++task) {
+                    count += counts[task * range + key];
+                }
+                first = std::fill_n(first, count, value);
+                // Don't go past the bounds of the range: the next
+                // value might not be representable
+                if (i + 1 == range) break;
+                if (descending) {
+                    --value;
+                } else {
+                    ++value;
+                }
+            }
         }
+
+        ////////////////////////////////////////////////////////////
+        // Counting sort of whole elements according to an integer
+        // key: every element is moved to its place in a buffer then
+        // moved back, which makes the algorithm stable
+
+        template<typename ForwardIterator, typename Compare, typename Projection>
+        auto counting_sort_records(ForwardIterator first, ForwardIterator last,
+                                   Compare compare, Projection projection)
+            -> void
+        {
+            using rvalue_reference = remove_cvref_t<rvalue_reference_t<ForwardIterator>>;
+            constexpr bool descending = std::is_same<Compare, std::greater<>>::value;
+            auto&& proj = utility::as_function(projection);
+
+            auto info = minmax_element_and_is_sorted(first, last, compare, projection);
+            if (info.is_sorted) return;
+
+            auto min = proj(descending ? *info.max : *info.min);
+            auto max = proj(descending ? *info.min : *info.max);
+            auto size = static_cast<std::size_t>(std::distance(first, last));
+            // A move constructor throwing during the scatter would leave
+            // the buffer partially constructed with no way to know which
+            // elements need to be destroyed
+            if (not is_range_small_enough(min, max, size) ||
+                not std::is_nothrow_move_constructible<rvalue_reference>::value) {
+                fallback_sort(std::move(first), std::move(last), size,
+                              std::move(compare), std::move(projection),
+                              iterator_category_t<ForwardIterator>{});
+                return;
+            }
+
+            std::size_t range = counter_index(max, min) + 1;
+            std::size_t nb_tasks = tasks_count(size, range, first, last,
+                                               iterator_category_t<ForwardIterator>{});
+            auto counts = make_histograms(first, last, size, min, range, nb_tasks, projection);
+
+            // Turn the counts into the positions where the elements of
+            // a given chunk and a given key go in the buffer
+            std::size_t total = 0;
+            for (std::size_t i = 0 ; i < range ; ++i) {
+                std::size_t key = descending ? range - 1 - i : i;
+                for (std::size_t task = 0 ; task < nb_tasks ; ++task) {
+                    auto& count = counts[task * range + key];
+                    auto nb_elements = count;
+                    count = total;
+                    total += nb_elements;
+                }
+            }
+
+            std::unique_ptr<rvalue_reference, operator_deleter> buffer(
+                allocate_buffer<rvalue_reference>(size),
+                operator_deleter(size * sizeof(rvalue_reference))
+            );
+
+            // Scatter the elements in the buffer, the projection was
+            // already called on every element by make_histograms
+            for_each_chunk(first, last, size, nb_tasks,
+                           [&](auto chunk_first, auto chunk_last, std::size_t task, std::size_t) {
+                using utility::iter_move;
+                auto positions = counts.data() + task * range;
+                for (; chunk_first != chunk_last ; ++chunk_first) {
+                    auto& pos = positions[counter_index(proj(*chunk_first), min)];
+                    ::new(buffer.get() + pos) rvalue_reference(iter_move(chunk_first));
+                    ++pos;
+                }
+            });
+            destruct_n<rvalue_reference> d(size);
+            std::unique_ptr<rvalue_reference, destruct_n<rvalue_reference>&> h2(buffer.get(), d);
+
+            // Move the elements back to the original collection
+            for_each_chunk(first, last, size, nb_tasks,
+                           [&](auto chunk_first, auto chunk_last, std::size_t, std::size_t offset) {
+                for (auto ptr = buffer.get() + offset ; chunk_first != chunk_last ; ++chunk_first, ++ptr) {
+                    *chunk_first = std::move(*ptr);
+                }
+            });
+        }
+    }
+
+    template<typename ForwardIterator>
+    auto counting_sort(ForwardIterator first, ForwardIterator last)
+        -> void
+    {
+        counting_sort_detail::counting_sort_values(std::move(first), std::move(last),
+                                                   std::less<>{});
+    }
+
+    template<typename ForwardIterator>
+    auto reverse_counting_sort(ForwardIterator first, ForwardIterator last)
+        -> void
+    {
+        counting_sort_detail::counting_sort_values(std::move(first), std::move(last),
+                                                   std::greater<>{});
+    }
+
+    template<typename ForwardIterator, typename Compare, typename Projection>
+    auto counting_sort(ForwardIterator first, ForwardIterator last,
+                       Compare compare, Projection projection)
+        -> void
+    {
+        counting_sort_detail::counting_sort_records(std::move(first), std::move(last),
+                                                    std::move(compare), std::move(projection));
     }
 }}
 
@@ -0,0 +1,380 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef CPPSORT_DETAIL_EXTERNAL_SORT_H_
+#define CPPSORT_DETAIL_EXTERNAL_SORT_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+#include <cpp-sort/utility/as_function.h>
+#include "iterator_traits.h"
+#include "loser_tree.h"
+
+#include <stdio.h>
+#ifndef _WIN32
+#   include <stdlib.h>
+#   include <sys/types.h>
+#   include <unistd.h>
+#endif
+
+namespace cppsort
+{
+namespace detail
+{
+    namespace external_sort_detail
+    {
+        enum {
+            // Runs are read and written by blocks of at least that
+            // many bytes, even when it means exceeding the memory
+            // budget, since smaller reads kill the throughput
+            min_block_bytes = 1 << 16
+        };
+
+        // Opens a temporary file which is removed once closed, in
+        // the given directory or in the default one if it is null
+        inline auto open_temporary_file(const char* directory)
+            -> std::FILE*
+        {
+            if (directory == nullptr) {
+                return std::tmpfile();
+            }
+#ifdef _WIN32
+            char* name = ::_tempnam(directory, "cppsort");
+            if (name == nullptr) {
+                return nullptr;
+            }
+            // D: the file is deleted when closed
+            std::FILE* file = std::fopen(name, "w+bD");
+            std::free(name);
+            return file;
+#else
+            std::string name = directory;
+            name += "/cpp-sort-XXXXXX";
+            int fd = ::mkstemp(&name[0]);
+            if (fd == -1) {
+                return nullptr;
+            }
+            // Unlinking the file right away ensures that it is
+            // removed when closed, even if the process crashes
+            ::unlink(name.c_str());
+            std::FILE* file = ::fdopen(fd, "w+b");
+            if (file == nullptr) {
+                ::close(fd);
+            }
+            return file;
+#endif
+        }
+
+        // 64-bit seek, std::fseek takes a long which only has
+        // 32 bits on some platforms
+        inline auto seek_file(std::FILE* file, std::uint64_t pos)
+            -> int
+        {
+#ifdef _WIN32
+            return ::_fseeki64(file, static_cast<__int64>(pos), SEEK_SET);
+#else
+            return ::fseeko(file, static_cast<off_t>(pos), SEEK_SET);
+#endif
+        }
+
+        // Anonymous temporary file, removed when closed
+        class temporary_file
+        {
+            public:
+
+                explicit temporary_file(const char* directory):
+                    file(open_temporary_file(directory))
+                {
+                    if (file == nullptr) {
+                        throw std::system_error(errno, std::generic_category(),
+                                                "external_sorter: can't create a temporary file");
+                    }
+                    // Reads and writes are already done by big blocks
+                    std::setvbuf(file, nullptr, _IONBF, 0);
+                }
+
+                temporary_file(const temporary_file&) = delete;
+                temporary_file& operator=(const temporary_file&) = delete;
+
+                ~temporary_file()
+                {
+                    std::fclose(file);
+                }
+
+                template<typename T>
+                auto write(const T* data, std::size_t size)
+                    -> void
+                {
+                    if (std::fwrite(data, sizeof(T), size, file) != size) {
+                        throw std::system_error(errno, std::generic_category(),
+                                                "external_sorter: can't write to a temporary file");
+                    }
+                }
+
+                template<typename T>
+                auto read(T* data, std::size_t size)
+                    -> void
+                {
+                    if (std::fread(data, sizeof(T), size, file) != size) {
+                        throw std::system_error(errno, std::generic_category(),
+                                                "external_sorter: can't read from a temporary file");
+                    }
+                }
+
+                template<typename T>
+                auto seek(std::size_t pos)
+                    -> void
+                {
+                    if (seek_file(file, std::uint64_t(pos) * sizeof(T)) != 0) {
+                        throw std::system_error(errno, std::generic_category(),
+                                                "external_sorter: can't seek in a temporary file");
+                    }
+                }
+
+            private:
+
+                std::FILE* file;
+        };
+
+        // Position of a sorted run in a temporary file, in elements
+        struct run_info
+        {
+            std::size_t offset;
+            std::size_t size;
+        };
+
+        // Sorted run spilled to a temporary file, read back
+        // sequentially through a buffer of its own
+        template<typename T>
+        class run_reader
+        {
+            public:
+
+                run_reader(temporary_file& file, run_info run, std::size_t buffer_size):
+                    file(&file),
+                    offset(run.offset),
+                    remaining(run.size),
+                    buffer(std::min(run.size, buffer_size)),
+                    pos(0),
+                    end(0)
+                {
+                    refill();
+                }
+
+                auto exhausted() const noexcept
+                    -> bool
+                {
+                    return pos == end;
+                }
+
+                auto head() const noexcept
+                    -> const T&
+                {
+                    return buffer[pos];
+                }
+
+                auto advance()
+                    -> void
+                {
+                    if (++pos == end) {
+                        refill();
+                    }
+                }
+
+            private:
+
+                auto refill()
+                    -> void
+                {
+                    // The runs share the same file
+                    auto size = std::min(remaining, buffer.size());
+                    if (size > 0) {
+                        file->template seek<T>(offset);
+                        file->read(buffer.data(), size);
+                    }
+                    offset += size;
+                    remaining -= size;
+                    pos = 0;
+                    end = size;
+                }
+
+                temporary_file* file;
+                std::size_t offset;
+                std::size_t remaining;
+                std::vector<T> buffer;
+                std::size_t pos;
+                std::size_t end;
+        };
+
+        // Merges the given runs of the file and passes every element
+        // in order to output, ties are won by the earliest run which
+        // keeps the merge stable
+        template<typename T, typename Compare, typename Projection, typename Output>
+        auto merge_runs(temporary_file& file, const run_info* runs, std::size_t nb_runs,
+                        std::size_t buffer_size, Compare compare, Projection projection,
+                        Output output)
+            -> void
+        {
+            auto&& comp = utility::as_function(compare);
+            auto&& proj = utility::as_function(projection);
+
+            std::size_t total = 0;
+            std::vector<run_reader<T>> readers;
+            readers.reserve(nb_runs);
+            for (std::size_t idx = 0 ; idx < nb_runs ; ++idx) {
+                readers.emplace_back(file, runs[idx], buffer_size);
+                total += runs[idx].size;
+            }
+
+            auto tree = make_loser_tree(nb_runs, [&](std::size_t lhs, std::size_t rhs) {
+                if (readers[lhs].exhausted()) return false;
+                if (readers[rhs].exhausted()) return true;
+                if (lhs < rhs) {
+                    return not comp(proj(readers[rhs].head()), proj(readers[lhs].head()));
+                }
+                return bool(comp(proj(readers[lhs].head()), proj(readers[rhs].head())));
+            });
+
+            for (; total > 0 ; --total) {
+                auto& reader = readers[tree.winner()];
+                output(reader.head());
+                reader.advance();
+                tree.replay();
+            }
+        }
+    }
+
+    template<typename Sorter, typename RandomAccessIterator,
+             typename Compare, typename Projection>
+    auto external_sort(RandomAccessIterator first, RandomAccessIterator last,
+                       std::size_t memory_budget, const char* temporary_directory,
+                       const Sorter& sorter, Compare compare, Projection projection)
+        -> void
+    {
+        using namespace external_sort_detail;
+        using value_type = value_type_t<RandomAccessIterator>;
+        using difference_type = difference_type_t<RandomAccessIterator>;
+
+        auto size = static_cast<std::size_t>(std::distance(first, last));
+        auto run_size = std::max<std::size_t>(memory_budget / sizeof(value_type), 1);
+        if (size <= run_size) {
+            sorter(std::move(first), std::move(last), std::move(compare), std::move(projection));
+            return;
+        }
+
+        ////////////////////////////////////////////////////////////
+        // Sort runs that fit in memory and spill them
+
+        // All the runs are written one after the other in the same
+        // file, which avoids running out of file descriptors
+        temporary_file file(temporary_directory);
+        std::vector<run_info> runs;
+        {
+            std::vector<value_type> buffer;
+            buffer.reserve(run_size);
+            for (std::size_t start = 0 ; start < size ; start += run_size) {
+                auto count = std::min(run_size, size - start);
+                auto run_first = first + static_cast<difference_type>(start);
+                buffer.assign(run_first, run_first + static_cast<difference_type>(count));
+                sorter(buffer.begin(), buffer.end(), compare, projection);
+
+                file.write(buffer.data(), count);
+                runs.push_back({ start, count });
+            }
+        }
+
+        ////////////////////////////////////////////////////////////
+        // Merge the runs back into the original range
+
+        // The memory budget is shared between the input buffers, but
+        // every buffer holds at least a big enough block: when there
+        // are too many runs for that, groups of runs are merged into
+        // another file until few enough runs remain
+        auto min_block = std::max<std::size_t>(min_block_bytes / sizeof(value_type), 1);
+        auto max_fan_in = std::max<std::size_t>(run_size / min_block, 2);
+        auto buffer_size = [&](std::size_t nb_runs) {
+            return std::max(run_size / nb_runs, min_block);
+        };
+
+        temporary_file* src = &file;
+        std::unique_ptr<temporary_file> other;
+        if (runs.size() > max_fan_in) {
+            other.reset(new temporary_file(temporary_directory));
+        }
+        temporary_file* dest = other.get();
+
+        std::vector<value_type> out_buffer;
+        while (runs.size() > max_fan_in) {
+            out_buffer.reserve(min_block);
+            std::vector<run_info> merged_runs;
+            dest->template seek<value_type>(0);
+            for (std::size_t idx = 0 ; idx < runs.size() ; idx += max_fan_in) {
+                auto nb_runs = std::min(max_fan_in, runs.size() - idx);
+                merge_runs<value_type>(
+                    *src, runs.data() + idx, nb_runs, buffer_size(nb_runs),
+                    compare, projection,
+                    [&](const value_type& value) {
+                        out_buffer.push_back(value);
+                        if (out_buffer.size() == min_block) {
+                            dest->write(out_buffer.data(), out_buffer.size());
+                            out_buffer.clear();
+                        }
+                    }
+                );
+                dest->write(out_buffer.data(), out_buffer.size());
+                out_buffer.clear();
+
+                run_info merged = { runs[idx].offset, 0 };
+                for (std::size_t run = idx ; run < idx + nb_runs ; ++run) {
+                    merged.size += runs[run].size;
+                }
+                merged_runs.push_back(merged);
+            }
+            runs = std::move(merged_runs);
+            std::swap(src, dest);
+        }
+
+        // Any exception thrown from now on leaves the original range
+        // with some of its elements overwritten
+        merge_runs<value_type>(
+            *src, runs.data(), runs.size(), buffer_size(runs.size()),
+            std::move(compare), std::move(projection),
+            [&](const value_type& value) { *first++ = value; }
+        );
+    }
+}}
+
+#endif // CPPSORT_DETAIL_EXTERNAL_SORT_H_
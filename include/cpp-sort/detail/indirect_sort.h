@@ -0,0 +1,89 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef CPPSORT_DETAIL_INDIRECT_SORT_H_
+#define CPPSORT_DETAIL_INDIRECT_SORT_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <cpp-sort/utility/as_function.h>
+
+namespace cppsort
+{
+namespace detail
+{
+    //
+    // Utilities used to sort elements that can't or shouldn't be
+    // moved directly, through an array of handles to them
+    //
+
+    ////////////////////////////////////////////////////////////
+    // Compact handle: the projected key is copied next to the
+    // position of the element it comes from so that the sort only
+    // touches contiguous memory
+
+    template<typename Key, typename Index>
+    struct key_index
+    {
+        Key key;
+        Index index;
+    };
+
+    // Compact handles are used when copying the projected keys is
+    // cheap and can't have side effects
+    template<typename Key>
+    using is_small_trivial_key = std::integral_constant<bool,
+        std::is_trivially_copyable<Key>::value &&
+        sizeof(Key) <= 2 * sizeof(std::uint64_t)
+    >;
+
+    ////////////////////////////////////////////////////////////
+    // Projection used to sort iterators on the values they point to
+
+    template<typename Iterator, typename Projection>
+    class indirect_projection
+    {
+        private:
+
+            using projection_t = decltype(utility::as_function(std::declval<Projection>()));
+            projection_t projection;
+
+        public:
+
+            explicit indirect_projection(Projection projection):
+                projection(utility::as_function(std::move(projection)))
+            {}
+
+            auto operator()(Iterator it)
+                -> decltype(projection(*it))
+            {
+                return projection(*it);
+            }
+    };
+}}
+
+#endif // CPPSORT_DETAIL_INDIRECT_SORT_H_
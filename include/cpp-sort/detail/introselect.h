@@ -37,6 +37,7 @@
 #include "insertion_sort.h"
 #include "iter_sort3.h"
 #include "iterator_traits.h"
+#include "network_sort.h"
 #include "partition.h"
 #include "swap_if.h"
 
@@ -67,6 +68,21 @@ namespace detail
                        std::move(compare), std::move(projection));
     }
 
+    template<typename RandomAccessIterator, typename Compare, typename Projection>
+    auto small_sort(RandomAccessIterator first, RandomAccessIterator last,
+                    difference_type_t<RandomAccessIterator> size,
+                    Compare compare, Projection projection,
+                    std::random_access_iterator_tag)
+        -> void
+    {
+        if (try_network_sort(first, last, compare, projection)) {
+            return;
+        }
+        small_sort(std::move(first), std::move(last), size,
+                   std::move(compare), std::move(projection),
+                   std::bidirectional_iterator_tag{});
+    }
+
     template<typename ForwardIterator, typename Compare, typename Projection>
     auto small_sort(ForwardIterator first, ForwardIterator last,
                     difference_type_t<ForwardIterator> size,
@@ -0,0 +1,129 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef CPPSORT_DETAIL_LOSER_TREE_H_
+#define CPPSORT_DETAIL_LOSER_TREE_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace cppsort
+{
+namespace detail
+{
+    //
+    // Tournament tree of losers used to repeatedly find the
+    // smallest head among k sorted sources with about log2(k)
+    // comparisons per extracted element
+    //
+    // The tree only stores source indices: beats(a, b) has to
+    // tell whether the current head of the source a should come
+    // before the current head of the source b. Exhausted sources
+    // are expected to lose against every other source, and ties
+    // should be broken by source index to get a stable merge
+    //
+
+    template<typename Beats>
+    class loser_tree
+    {
+        public:
+
+            ////////////////////////////////////////////////////////////
+            // Construction
+
+            loser_tree(std::size_t nb_sources, Beats beats):
+                nb_sources(nb_sources),
+                nodes(nb_sources == 0 ? 1 : nb_sources),
+                beats(std::move(beats))
+            {
+                if (nb_sources < 2) {
+                    nodes[0] = 0;
+                    return;
+                }
+
+                // Leaves are the virtual nodes [nb_sources, 2 * nb_sources),
+                // internal nodes keep the loser of their match while the
+                // winners are carried upwards
+                std::vector<std::size_t> winners(nb_sources);
+                for (std::size_t node = nb_sources - 1 ; node > 0 ; --node) {
+                    auto left = winner_of(2 * node, winners);
+                    auto right = winner_of(2 * node + 1, winners);
+                    if (this->beats(right, left)) {
+                        std::swap(left, right);
+                    }
+                    winners[node] = left;
+                    nodes[node] = right;
+                }
+                nodes[0] = winners[1];
+            }
+
+            ////////////////////////////////////////////////////////////
+            // Tournament
+
+            // Source whose head currently comes first
+            auto winner() const noexcept
+                -> std::size_t
+            {
+                return nodes[0];
+            }
+
+            // Plays the matches again from the leaf of the winner,
+            // to be called once the head of the winner changed
+            auto replay()
+                -> void
+            {
+                auto winner = nodes[0];
+                for (auto node = (winner + nb_sources) / 2 ; node > 0 ; node /= 2) {
+                    if (beats(nodes[node], winner)) {
+                        std::swap(nodes[node], winner);
+                    }
+                }
+                nodes[0] = winner;
+            }
+
+        private:
+
+            auto winner_of(std::size_t node, const std::vector<std::size_t>& winners) const
+                -> std::size_t
+            {
+                return node >= nb_sources ? node - nb_sources : winners[node];
+            }
+
+            std::size_t nb_sources;
+            std::vector<std::size_t> nodes;
+            Beats beats;
+    };
+
+    template<typename Beats>
+    auto make_loser_tree(std::size_t nb_sources, Beats beats)
+        -> loser_tree<Beats>
+    {
+        return loser_tree<Beats>(nb_sources, std::move(beats));
+    }
+}}
+
+#endif // CPPSORT_DETAIL_LOSER_TREE_H_
@@ -0,0 +1,205 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef CPPSORT_DETAIL_LSD_RADIX_SORT_H_
+#define CPPSORT_DETAIL_LSD_RADIX_SORT_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <cpp-sort/utility/as_function.h>
+#include <cpp-sort/utility/iter_move.h>
+#include "iterator_traits.h"
+#include "merge_sort.h"
+#include "move.h"
+#include "ska_sort.h"
+#include "type_traits.h"
+
+namespace cppsort
+{
+namespace detail
+{
+    namespace lsd_radix_sort_detail
+    {
+        enum {
+            // Collections smaller than this are sorted with a
+            // comparison sort, which is faster than clearing and
+            // scanning the histograms
+            merge_sort_threshold = 128,
+
+            // Number of different values of a digit
+            radix = 256
+        };
+
+        // Unsigned integer to which to_unsigned_or_bool maps a key
+        template<typename T>
+        using radix_key_t = decltype(to_unsigned_or_bool(std::declval<T>()));
+
+        // Projects a value to the unsigned integer used as its key,
+        // which is used to sort small collections with a comparison
+        // sort in the same order as the radix sort
+        template<typename Projection>
+        struct radix_key_projection
+        {
+            Projection projection;
+
+            template<typename T>
+            auto operator()(T&& value) const
+                -> decltype(auto)
+            {
+                auto&& proj = utility::as_function(projection);
+                return to_unsigned_or_bool(proj(std::forward<T>(value)));
+            }
+        };
+
+        template<typename Key>
+        auto digit_of(Key key, int digit) noexcept
+            -> std::size_t
+        {
+            return static_cast<std::size_t>(key >> (CHAR_BIT * digit)) & (radix - 1);
+        }
+
+        template<typename InputIterator, typename OutputIterator, typename Projection>
+        auto scatter(InputIterator first, InputIterator last, OutputIterator result,
+                     std::size_t* offsets, int digit, Projection projection)
+            -> void
+        {
+            using utility::iter_move;
+            auto&& proj = utility::as_function(projection);
+
+            for (; first != last ; ++first) {
+                auto idx = digit_of(to_unsigned_or_bool(proj(*first)), digit);
+                result[offsets[idx]++] = iter_move(first);
+            }
+        }
+    }
+
+    template<typename BufferProvider, typename RandomAccessIterator, typename Projection>
+    auto lsd_radix_sort(RandomAccessIterator first, RandomAccessIterator last,
+                        Projection projection)
+        -> void
+    {
+        using namespace lsd_radix_sort_detail;
+        using rvalue_reference = remove_cvref_t<rvalue_reference_t<RandomAccessIterator>>;
+        using key_type = radix_key_t<projected_t<RandomAccessIterator, Projection>>;
+        constexpr int nb_digits = sizeof(key_type);
+        auto&& proj = utility::as_function(projection);
+
+        auto size = std::distance(first, last);
+        if (size < 2) return;
+        auto usize = static_cast<std::size_t>(size);
+
+        if (size < merge_sort_threshold) {
+            merge_sort(std::move(first), std::move(last), size, std::less<>{},
+                       radix_key_projection<Projection>{std::move(projection)});
+            return;
+        }
+
+        typename BufferProvider::template buffer<rvalue_reference> buffer(usize);
+        if (buffer.size() < usize) {
+            // The ping-pong buffer has to be as big as the collection
+            merge_sort(std::move(first), std::move(last), size, std::less<>{},
+                       radix_key_projection<Projection>{std::move(projection)});
+            return;
+        }
+
+        // Compute the histograms of every digit in a single pass
+        std::size_t counts[nb_digits][radix] = {};
+        for (auto it = first ; it != last ; ++it) {
+            auto key = to_unsigned_or_bool(proj(*it));
+            for (int digit = 0 ; digit < nb_digits ; ++digit) {
+                ++counts[digit][digit_of(key, digit)];
+            }
+        }
+
+        // Sort the elements digit by digit, moving them back and forth
+        // between the collection and the buffer; the digits that are
+        // the same for every element are skipped
+        auto first_key = to_unsigned_or_bool(proj(*first));
+        bool data_in_buffer = false;
+        for (int digit = 0 ; digit < nb_digits ; ++digit) {
+            std::size_t* offsets = counts[digit];
+            if (offsets[digit_of(first_key, digit)] == usize) continue;
+
+            std::size_t sum = 0;
+            for (int idx = 0 ; idx < radix ; ++idx) {
+                auto count = offsets[idx];
+                offsets[idx] = sum;
+                sum += count;
+            }
+
+            if (data_in_buffer) {
+                scatter(buffer.begin(), buffer.begin() + size, first,
+                        offsets, digit, projection);
+            } else {
+                scatter(first, last, buffer.begin(),
+                        offsets, digit, projection);
+            }
+            data_in_buffer = not data_in_buffer;
+        }
+
+        if (data_in_buffer) {
+            detail::move(buffer.begin(), buffer.begin() + size, first);
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Whether a type is sortable with lsd_radix_sort
+
+    // Only the keys that to_unsigned_or_bool maps to an unsigned
+    // integer of at most 64 bits are handled
+
+    template<typename T>
+    struct is_lsd_radix_sortable:
+        std::integral_constant<bool,
+            is_integral<T>::value && sizeof(T) <= sizeof(std::uint64_t)
+        >
+    {};
+
+    template<typename T>
+    struct is_lsd_radix_sortable<T*>:
+        std::true_type
+    {};
+
+    template<>
+    struct is_lsd_radix_sortable<float>:
+        is_ska_sortable<float>
+    {};
+
+    template<>
+    struct is_lsd_radix_sortable<double>:
+        is_ska_sortable<double>
+    {};
+
+    template<typename T>
+    constexpr bool is_lsd_radix_sortable_v = is_lsd_radix_sortable<T>::value;
+}}
+
+#endif // CPPSORT_DETAIL_LSD_RADIX_SORT_H_
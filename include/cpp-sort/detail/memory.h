@@ -19,6 +19,8 @@
 #include <limits>
 #include <new>
 #include <type_traits>
+#include <vector>
+#include <cpp-sort/utility/memory_resource.h>
 #include "type_traits.h"
 
 namespace cppsort
@@ -26,35 +28,108 @@ namespace cppsort
 namespace detail
 {
     ////////////////////////////////////////////////////////////
-    // Deleter for ::operator new(std::size_t)
+    // Raw memory allocation
 
-    struct operator_deleter
+    // Allocates memory for count objects from the memory resource
+    // of the current thread, or with ::operator new without one
+    template<typename T>
+    auto allocate_buffer(std::size_t count)
+        -> T*
     {
-        operator_deleter() = default;
+        auto resource = utility::scoped_memory_resource::current();
+        if (resource != nullptr) {
+            return static_cast<T*>(resource->allocate(count * sizeof(T)));
+        }
+        return static_cast<T*>(::operator new(count * sizeof(T)));
+    }
 
-#ifdef __cpp_sized_deallocation
+    ////////////////////////////////////////////////////////////
+    // Deleter for allocate_buffer
+
+    // The memory resource of the current thread when the deleter
+    // is created is the one the memory is given back to
+    struct operator_deleter
+    {
         std::size_t size = 0;
+        utility::memory_resource* resource = nullptr;
+
+        operator_deleter() = default;
 
-        constexpr explicit operator_deleter(std::size_t size) noexcept:
-            size(size)
+        explicit operator_deleter(std::size_t size) noexcept:
+            size(size),
+            resource(utility::scoped_memory_resource::current())
         {}
 
         inline auto operator()(void* pointer) const noexcept
             -> void
         {
+            if (resource != nullptr) {
+                resource->deallocate(pointer, size);
+                return;
+            }
+#ifdef __cpp_sized_deallocation
             ::operator delete(pointer, size);
-        }
 #else
-        constexpr explicit operator_deleter(std::size_t) noexcept {}
+            ::operator delete(pointer);
+#endif
+        }
+    };
 
-        inline auto operator()(void* pointer) const noexcept
+    ////////////////////////////////////////////////////////////
+    // Allocator for the standard containers
+
+    // Allocator for the temporary containers of the algorithms,
+    // it uses the memory resource of the current thread when it
+    // is created
+    template<typename T>
+    struct temporary_allocator
+    {
+        using value_type = T;
+
+        utility::memory_resource* resource = utility::scoped_memory_resource::current();
+
+        temporary_allocator() = default;
+
+        template<typename U>
+        temporary_allocator(const temporary_allocator<U>& other) noexcept:
+            resource(other.resource)
+        {}
+
+        auto allocate(std::size_t count)
+            -> T*
+        {
+            if (resource != nullptr) {
+                return static_cast<T*>(resource->allocate(count * sizeof(T)));
+            }
+            return static_cast<T*>(::operator new(count * sizeof(T)));
+        }
+
+        auto deallocate(T* pointer, std::size_t count) noexcept
             -> void
         {
-            ::operator delete(pointer);
+            operator_deleter deleter(count * sizeof(T));
+            deleter.resource = resource;
+            deleter(pointer);
         }
-#endif
     };
 
+    template<typename T, typename U>
+    auto operator==(const temporary_allocator<T>& lhs, const temporary_allocator<U>& rhs) noexcept
+        -> bool
+    {
+        return lhs.resource == rhs.resource;
+    }
+
+    template<typename T, typename U>
+    auto operator!=(const temporary_allocator<T>& lhs, const temporary_allocator<U>& rhs) noexcept
+        -> bool
+    {
+        return lhs.resource != rhs.resource;
+    }
+
+    template<typename T>
+    using temporary_vector = std::vector<T, temporary_allocator<T>>;
+
     ////////////////////////////////////////////////////////////
     // Deleter for placement new-allocated memory
 
@@ -132,8 +207,17 @@ namespace detail
 
         // Try to gradually allocate less memory until we get a valid buffer
         // or until the amount of memory to allocate reaches 0
+        auto resource = utility::scoped_memory_resource::current();
         while (count > min_count) {
-            res.first = static_cast<T*>(::operator new(count * sizeof(T), std::nothrow));
+            if (resource != nullptr) {
+                try {
+                    res.first = static_cast<T*>(resource->allocate(count * sizeof(T)));
+                } catch (...) {
+                    res.first = nullptr;
+                }
+            } else {
+                res.first = static_cast<T*>(::operator new(count * sizeof(T), std::nothrow));
+            }
             if (res.first) {
                 res.second = count;
                 break;
@@ -147,6 +231,13 @@ namespace detail
     auto return_temporary_buffer(T* ptr, std::size_t count) noexcept
         -> void
     {
+        auto resource = utility::scoped_memory_resource::current();
+        if (resource != nullptr) {
+            if (ptr != nullptr) {
+                resource->deallocate(ptr, count * sizeof(T));
+            }
+            return;
+        }
 #ifdef __cpp_sized_deallocation
         ::operator delete(ptr, count * sizeof(T));
 #else
@@ -433,7 +433,7 @@ namespace detail
 
         using rvalue_reference = remove_cvref_t<rvalue_reference_t<RandomAccessIterator>>;
         std::unique_ptr<rvalue_reference, operator_deleter> cache(
-            static_cast<rvalue_reference*>(::operator new(full_size * sizeof(rvalue_reference))),
+            allocate_buffer<rvalue_reference>(full_size),
             operator_deleter(full_size * sizeof(rvalue_reference))
         );
         destruct_n<rvalue_reference> d(0);
@@ -0,0 +1,136 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef CPPSORT_DETAIL_NETWORK_SORT_H_
+#define CPPSORT_DETAIL_NETWORK_SORT_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <cpp-sort/fixed/sorting_network_sorter.h>
+#include <cpp-sort/utility/branchless_traits.h>
+#include "config.h"
+#include "iterator_traits.h"
+
+namespace cppsort
+{
+namespace detail
+{
+    //
+    // Runtime dispatch of small collections to the sorting
+    // networks: the size of the collection is used as an index
+    // in a table of sorting_network_sorter<N> instances, which
+    // allows the algorithms to finish the sort of their small
+    // partitions with networks instead of insertion sort
+    //
+    // Sorting networks perform more comparisons than insertion
+    // sort but never branch on their results, so they are only
+    // used when the comparison and the projection are probably
+    // branchless
+    //
+
+    // Biggest collection that can be sorted by network_sort
+    constexpr std::ptrdiff_t network_sort_max_size = 32;
+
+    template<typename RandomAccessIterator, typename Compare, typename Projection>
+    using can_network_sort = std::integral_constant<bool,
+        utility::is_probably_branchless_comparison_v<
+            Compare,
+            projected_t<RandomAccessIterator, Projection>
+        > &&
+        utility::is_probably_branchless_projection_v<
+            Projection,
+            value_type_t<RandomAccessIterator>
+        >
+    >;
+
+    template<std::size_t N, typename RandomAccessIterator,
+             typename Compare, typename Projection>
+    auto network_sort_kernel(RandomAccessIterator first, RandomAccessIterator last,
+                             Compare compare, Projection projection)
+        -> void
+    {
+        sorting_network_sorter<N>{}(std::move(first), std::move(last),
+                                    std::move(compare), std::move(projection));
+    }
+
+    template<typename RandomAccessIterator, typename Compare,
+             typename Projection, std::size_t... Indices>
+    auto network_sort(RandomAccessIterator first, RandomAccessIterator last,
+                      Compare compare, Projection projection,
+                      std::index_sequence<Indices...>)
+        -> void
+    {
+        using kernel_type = void(*)(RandomAccessIterator, RandomAccessIterator,
+                                    Compare, Projection);
+        static constexpr kernel_type kernels[] = {
+            &network_sort_kernel<Indices, RandomAccessIterator, Compare, Projection>...
+        };
+
+        auto size = last - first;
+        CPPSORT_ASSERT(size >= 0 && size <= network_sort_max_size);
+        kernels[size](std::move(first), std::move(last),
+                      std::move(compare), std::move(projection));
+    }
+
+    // Sorts [first, last) with a sorting network and returns true
+    // when it is small enough and the comparison is branchless,
+    // otherwise returns false without touching the collection
+
+    template<typename RandomAccessIterator, typename Compare, typename Projection>
+    auto try_network_sort(RandomAccessIterator, RandomAccessIterator,
+                          Compare, Projection, std::false_type)
+        -> bool
+    {
+        return false;
+    }
+
+    template<typename RandomAccessIterator, typename Compare, typename Projection>
+    auto try_network_sort(RandomAccessIterator first, RandomAccessIterator last,
+                          Compare compare, Projection projection, std::true_type)
+        -> bool
+    {
+        if (last - first > network_sort_max_size) {
+            return false;
+        }
+        network_sort(std::move(first), std::move(last),
+                     std::move(compare), std::move(projection),
+                     std::make_index_sequence<network_sort_max_size + 1>{});
+        return true;
+    }
+
+    template<typename RandomAccessIterator, typename Compare, typename Projection>
+    auto try_network_sort(RandomAccessIterator first, RandomAccessIterator last,
+                          Compare compare, Projection projection)
+        -> bool
+    {
+        return try_network_sort(std::move(first), std::move(last),
+                                std::move(compare), std::move(projection),
+                                can_network_sort<RandomAccessIterator, Compare, Projection>{});
+    }
+}}
+
+#endif // CPPSORT_DETAIL_NETWORK_SORT_H_
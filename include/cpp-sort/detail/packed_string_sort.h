@@ -0,0 +1,248 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef CPPSORT_DETAIL_PACKED_STRING_SORT_H_
+#define CPPSORT_DETAIL_PACKED_STRING_SORT_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <utility>
+#include <vector>
+#include <cpp-sort/utility/as_function.h>
+#include <cpp-sort/utility/functional.h>
+#include <cpp-sort/utility/iter_move.h>
+#include "pdqsort.h"
+#include "ska_sort.h"
+#include "spreadsort/detail/string_sort.h"
+
+namespace cppsort
+{
+namespace detail
+{
+    namespace packed_string_sort_detail
+    {
+        enum {
+            // Number of characters packed in a key, the lowest
+            // byte of the key holds the number of characters that
+            // were actually available
+            packed_chars = 7,
+
+            // Groups smaller than this are sorted by comparing the
+            // remaining characters of the strings instead
+            comparison_sort_threshold = 32
+        };
+
+        // Compact record sorted in place of a string: the packed key
+        // is read from the record itself and the characters of the
+        // string are only accessed again to break ties
+        struct packed_record
+        {
+            std::uint64_t key;
+            const unsigned char* data;
+            std::size_t size;
+            std::size_t index;
+        };
+
+        // Minimal string-like view of a record, for the helpers
+        // of spreadsort's string_sort
+        struct record_view
+        {
+            const packed_record* record;
+
+            auto size() const noexcept
+                -> std::size_t
+            {
+                return record->size;
+            }
+
+            auto data() const noexcept
+                -> const unsigned char*
+            {
+                return record->data;
+            }
+        };
+
+        struct to_record_view
+        {
+            auto operator()(const packed_record& record) const noexcept
+                -> record_view
+            {
+                return { &record };
+            }
+        };
+
+        // Compares strings known to share their first offset characters
+        struct compare_from_offset
+        {
+            std::size_t offset;
+
+            auto operator()(const packed_record& lhs, const packed_record& rhs) const noexcept
+                -> bool
+            {
+                auto size = std::min(lhs.size, rhs.size) - offset;
+                int res = std::memcmp(lhs.data + offset, rhs.data + offset, size);
+                return res < 0 || (res == 0 && lhs.size < rhs.size);
+            }
+        };
+
+        // Packs the characters [offset, offset + packed_chars) of a
+        // string in big-endian order, followed by the number of those
+        // characters that exist: comparing the keys is then the same
+        // as comparing the strings, provided that they share the
+        // same first offset characters
+        inline auto pack_key(const packed_record& record, std::size_t offset) noexcept
+            -> std::uint64_t
+        {
+            std::size_t remaining = record.size - offset;
+            const unsigned char* chars = record.data + offset;
+
+            std::uint64_t key = 0;
+            if (remaining >= packed_chars) {
+                for (int idx = 0 ; idx < packed_chars ; ++idx) {
+                    key = (key << 8) | chars[idx];
+                }
+                return (key << 8) | packed_chars;
+            }
+
+            for (std::size_t idx = 0 ; idx < remaining ; ++idx) {
+                key = (key << 8) | chars[idx];
+            }
+            key <<= 8 * (packed_chars - remaining);
+            return (key << 8) | remaining;
+        }
+
+        // Moves the elements of the original collection to match the
+        // order of the sorted records, following the cycles of the
+        // permutation
+        template<typename RandomAccessIterator>
+        auto apply_permutation(RandomAccessIterator first, std::vector<packed_record>& records)
+            -> void
+        {
+            using utility::iter_move;
+
+            for (std::size_t start = 0 ; start < records.size() ; ++start) {
+                if (records[start].index == start) continue;
+
+                auto tmp = iter_move(first + start);
+                std::size_t current = start;
+                while (records[current].index != start) {
+                    std::size_t next = records[current].index;
+                    first[current] = iter_move(first + next);
+                    records[current].index = current;
+                    current = next;
+                }
+                first[current] = std::move(tmp);
+                records[current].index = current;
+            }
+        }
+    }
+
+    template<typename RandomAccessIterator, typename Projection>
+    auto packed_string_sort(RandomAccessIterator first, RandomAccessIterator last,
+                            Projection projection)
+        -> void
+    {
+        using namespace packed_string_sort_detail;
+        auto&& proj = utility::as_function(projection);
+
+        auto size = static_cast<std::size_t>(std::distance(first, last));
+        if (size < 2) return;
+
+        std::vector<packed_record> records;
+        records.reserve(size);
+        for (std::size_t idx = 0 ; idx < size ; ++idx) {
+            const auto& str = proj(first[idx]);
+            records.push_back({
+                0,
+                reinterpret_cast<const unsigned char*>(str.data()),
+                str.size(),
+                idx
+            });
+        }
+
+        // Groups of records whose strings share the same first
+        // characters, and the number of such characters
+        struct group
+        {
+            std::size_t begin;
+            std::size_t end;
+            std::size_t offset;
+        };
+        std::vector<group> groups = { { 0, size, 0 } };
+
+        while (not groups.empty()) {
+            auto grp = groups.back();
+            groups.pop_back();
+            auto begin = records.begin() + grp.begin;
+            auto end = records.begin() + grp.end;
+
+            // Strings that have no character left are equal to each
+            // other and sort before the other ones of the group
+            begin = std::partition(begin, end, [&](const packed_record& record) {
+                return record.size == grp.offset;
+            });
+            if (end - begin < 2) continue;
+
+            if (end - begin < comparison_sort_threshold) {
+                pdqsort(begin, end, compare_from_offset{grp.offset}, utility::identity{});
+                continue;
+            }
+
+            // Skip the characters shared by every string of the group
+            spreadsort::detail::update_offset<unsigned char>(begin, end, grp.offset,
+                                                             to_record_view{});
+
+            for (auto it = begin ; it != end ; ++it) {
+                it->key = pack_key(*it, grp.offset);
+            }
+            ska_sort(begin, end, &packed_record::key);
+
+            // Strings whose keys are equal and that have characters
+            // left past the packed ones still need to be sorted
+            for (auto it = begin ; it != end ;) {
+                auto next = it + 1;
+                while (next != end && next->key == it->key) {
+                    ++next;
+                }
+                if (next - it > 1 && (it->key & 0xff) == packed_chars) {
+                    groups.push_back({
+                        static_cast<std::size_t>(it - records.begin()),
+                        static_cast<std::size_t>(next - records.begin()),
+                        grp.offset + packed_chars
+                    });
+                }
+                it = next;
+            }
+        }
+
+        apply_permutation(first, records);
+    }
+}}
+
+#endif // CPPSORT_DETAIL_PACKED_STRING_SORT_H_
@@ -0,0 +1,354 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef CPPSORT_DETAIL_PARALLEL_MERGE_SORT_H_
+#define CPPSORT_DETAIL_PARALLEL_MERGE_SORT_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+#include <cpp-sort/utility/as_function.h>
+#include "inplace_merge.h"
+#include "iterator_traits.h"
+#include "memory.h"
+#include "merge_move.h"
+#include "merge_sort.h"
+#include "move.h"
+#include "task_pool.h"
+#include "type_traits.h"
+
+namespace cppsort
+{
+namespace detail
+{
+    namespace parallel_merge_sort_detail
+    {
+        enum {
+            // Collections are not split into chunks smaller than
+            // this, the sequential merge_sort is used instead
+            min_chunk_size = 4096
+        };
+
+        // Finds the number of elements coming from [first1, first1 + size1)
+        // among the first k elements of the stable merge of both ranges,
+        // which gives independent starting points to several threads
+        // merging different slices of the same output (merge path)
+        template<typename RandomAccessIterator, typename Compare, typename Projection>
+        auto co_rank(RandomAccessIterator first1, std::ptrdiff_t size1,
+                     RandomAccessIterator first2, std::ptrdiff_t size2,
+                     std::ptrdiff_t k, Compare compare, Projection projection)
+            -> std::ptrdiff_t
+        {
+            auto&& comp = utility::as_function(compare);
+            auto&& proj = utility::as_function(projection);
+
+            auto lo = std::max<std::ptrdiff_t>(0, k - size2);
+            auto hi = std::min(k, size1);
+            while (lo < hi) {
+                auto mid = lo + (hi - lo) / 2;
+                // Elements of the first range win ties
+                if (comp(proj(first2[k - mid - 1]), proj(first1[mid]))) {
+                    hi = mid;
+                } else {
+                    lo = mid + 1;
+                }
+            }
+            return lo;
+        }
+
+        // Merges pairs of consecutive sorted runs of [src, src + size) into
+        // dest, the run boundaries being given by bounds; every merge is
+        // split into output slices of at most slice_size elements so that
+        // each task writes a disjoint part of dest
+        template<typename Iterator1, typename Iterator2,
+                 typename Compare, typename Projection>
+        auto merge_round(Iterator1 src, Iterator2 dest,
+                         const std::vector<std::ptrdiff_t>& bounds,
+                         std::ptrdiff_t slice_size,
+                         Compare compare, Projection projection,
+                         task_group& group)
+            -> void
+        {
+            std::vector<std::ptrdiff_t> splits;
+            auto nb_runs = bounds.size() - 1;
+            for (std::size_t run = 0 ; run < nb_runs ; run += 2) {
+                auto begin = bounds[run];
+                if (run + 1 == nb_runs) {
+                    // Odd run out, only move it to the other side
+                    auto end = bounds[run + 1];
+                    for (auto start = begin ; start < end ; start += slice_size) {
+                        auto stop = std::min(start + slice_size, end);
+                        group.run([=] {
+                            detail::move(src + start, src + stop, dest + start);
+                        });
+                    }
+                    break;
+                }
+
+                auto middle = bounds[run + 1];
+                auto end = bounds[run + 2];
+                auto first1 = src + begin;
+                auto first2 = src + middle;
+                auto size1 = middle - begin;
+                auto size2 = end - middle;
+
+                // The split points have to be computed before any task
+                // starts moving elements out of the merged runs
+                splits.clear();
+                for (std::ptrdiff_t k = 0 ; k < size1 + size2 ; k += slice_size) {
+                    splits.push_back(co_rank(first1, size1, first2, size2, k, compare, projection));
+                }
+                splits.push_back(size1);
+
+                for (std::size_t slice = 0 ; slice + 1 < splits.size() ; ++slice) {
+                    auto k = static_cast<std::ptrdiff_t>(slice) * slice_size;
+                    auto k_end = std::min(k + slice_size, size1 + size2);
+                    auto i = splits[slice];
+                    auto i_end = splits[slice + 1];
+                    group.run([=] {
+                        merge_move(first1 + i, first1 + i_end,
+                                   first2 + (k - i), first2 + (k_end - i_end),
+                                   dest + (begin + k),
+                                   compare, projection, projection);
+                    });
+                }
+            }
+            group.wait();
+        }
+
+        // Drops every other boundary once pairs of runs are merged
+        inline auto merge_bounds(std::vector<std::ptrdiff_t>& bounds)
+            -> void
+        {
+            std::size_t pos = 0;
+            for (std::size_t idx = 0 ; idx < bounds.size() ; idx += 2) {
+                bounds[pos++] = bounds[idx];
+            }
+            if (bounds.size() % 2 == 0) {
+                // The last boundary was skipped
+                bounds[pos++] = bounds.back();
+            }
+            bounds.resize(pos);
+        }
+
+        // Removes the boundaries between consecutive sorted runs that
+        // are already in order, which happens when a run of the input
+        // crosses the boundary between two chunks
+        template<typename RandomAccessIterator, typename Compare, typename Projection>
+        auto stitch_bounds(RandomAccessIterator first, std::vector<std::ptrdiff_t>& bounds,
+                           Compare compare, Projection projection)
+            -> void
+        {
+            auto&& comp = utility::as_function(compare);
+            auto&& proj = utility::as_function(projection);
+
+            std::size_t pos = 1;
+            for (std::size_t idx = 1 ; idx + 1 < bounds.size() ; ++idx) {
+                if (comp(proj(first[bounds[idx]]), proj(first[bounds[idx] - 1]))) {
+                    bounds[pos++] = bounds[idx];
+                }
+            }
+            bounds[pos++] = bounds.back();
+            bounds.resize(pos);
+        }
+
+        // Destroys the elements constructed in the auxiliary buffer,
+        // chunk by chunk since they are constructed in parallel
+        template<typename T>
+        struct chunks_destructor
+        {
+            T* buffer;
+            std::vector<std::ptrdiff_t> bounds;
+            std::unique_ptr<bool[]> constructed;
+
+            ~chunks_destructor()
+            {
+                for (std::size_t idx = 0 ; idx + 1 < bounds.size() ; ++idx) {
+                    if (constructed[idx]) {
+                        destruct_n<T> d(static_cast<std::size_t>(bounds[idx + 1] - bounds[idx]));
+                        d(buffer + bounds[idx]);
+                    }
+                }
+            }
+        };
+    }
+
+    // Sorts nb_threads chunks of [first, last) concurrently with
+    // sort_chunk, then merges the resulting runs with a parallel
+    // merge tree; consecutive chunks already in order once sorted
+    // are stitched together instead of being merged
+    template<typename RandomAccessIterator, typename Compare,
+             typename Projection, typename ChunkSorter>
+    auto parallel_sort_chunks(RandomAccessIterator first, RandomAccessIterator last,
+                              Compare compare, Projection projection,
+                              std::size_t nb_threads, ChunkSorter sort_chunk)
+        -> void
+    {
+        using namespace parallel_merge_sort_detail;
+        using rvalue_reference = remove_cvref_t<rvalue_reference_t<RandomAccessIterator>>;
+
+        auto size = std::distance(first, last);
+        auto usize = static_cast<std::size_t>(size);
+
+        // Boundaries of the chunks to sort, one per thread
+        std::vector<std::ptrdiff_t> bounds;
+        bounds.reserve(nb_threads + 1);
+        for (std::size_t idx = 0 ; idx <= nb_threads ; ++idx) {
+            bounds.push_back(static_cast<std::ptrdiff_t>(idx * usize / nb_threads));
+        }
+        auto slice_size = static_cast<std::ptrdiff_t>((usize + nb_threads - 1) / nb_threads);
+
+        // Merging out of place requires a buffer as big as the whole
+        // collection, we fall back to in-place merges without it
+        auto tmp = get_temporary_buffer<rvalue_reference>(size, size - 1);
+        std::unique_ptr<rvalue_reference, operator_deleter> buffer(
+            tmp.first,
+            operator_deleter(static_cast<std::size_t>(tmp.second) * sizeof(rvalue_reference))
+        );
+        chunks_destructor<rvalue_reference> destructor{
+            buffer.get(), bounds, std::unique_ptr<bool[]>(new bool[nb_threads]())
+        };
+
+        // The current thread takes part in the sort, the group has to
+        // be destroyed before the buffer since it waits for the tasks
+        auto& pool = task_pool::shared(nb_threads - 1);
+        task_group group(pool);
+
+        if (not buffer) {
+            for (std::size_t idx = 0 ; idx < nb_threads ; ++idx) {
+                group.run([=, &bounds] {
+                    sort_chunk(first + bounds[idx], first + bounds[idx + 1],
+                               bounds[idx + 1] - bounds[idx],
+                               compare, projection);
+                });
+            }
+            group.wait();
+            stitch_bounds(first, bounds, compare, projection);
+
+            while (bounds.size() > 2) {
+                for (std::size_t idx = 0 ; idx + 2 < bounds.size() ; idx += 2) {
+                    group.run([=, &bounds] {
+                        inplace_merge(first + bounds[idx],
+                                      first + bounds[idx + 1],
+                                      first + bounds[idx + 2],
+                                      compare, projection);
+                    });
+                }
+                group.wait();
+                merge_bounds(bounds);
+            }
+            return;
+        }
+
+        // Sort the chunks and move them to the buffer in the same task
+        // while they are hot in cache, the buffer then holds the data
+        // for the first round of merges
+        for (std::size_t idx = 0 ; idx < nb_threads ; ++idx) {
+            group.run([=, &bounds, &destructor] {
+                auto chunk_first = first + bounds[idx];
+                auto chunk_last = first + bounds[idx + 1];
+                sort_chunk(chunk_first, chunk_last, bounds[idx + 1] - bounds[idx],
+                           compare, projection);
+
+                destruct_n<rvalue_reference> d(0);
+                std::unique_ptr<rvalue_reference, destruct_n<rvalue_reference>&> h2(
+                    destructor.buffer + bounds[idx], d
+                );
+                uninitialized_move(chunk_first, chunk_last, destructor.buffer + bounds[idx], d);
+                h2.release();
+                destructor.constructed[idx] = true;
+            });
+        }
+        group.wait();
+        stitch_bounds(buffer.get(), bounds, compare, projection);
+
+        // Merge pairs of runs back and forth between the buffer
+        // and the original collection
+        bool data_in_buffer = true;
+        while (bounds.size() > 2) {
+            if (data_in_buffer) {
+                merge_round(buffer.get(), first, bounds, slice_size,
+                            compare, projection, group);
+            } else {
+                merge_round(first, buffer.get(), bounds, slice_size,
+                            compare, projection, group);
+            }
+            data_in_buffer = not data_in_buffer;
+            merge_bounds(bounds);
+        }
+
+        if (data_in_buffer) {
+            for (std::ptrdiff_t start = 0 ; start < size ; start += slice_size) {
+                auto stop = std::min<std::ptrdiff_t>(start + slice_size, size);
+                auto ptr = buffer.get();
+                group.run([=] {
+                    detail::move(ptr + start, ptr + stop, first + start);
+                });
+            }
+            group.wait();
+        }
+    }
+
+    template<typename RandomAccessIterator, typename Compare, typename Projection>
+    auto parallel_merge_sort(RandomAccessIterator first, RandomAccessIterator last,
+                             Compare compare, Projection projection,
+                             std::size_t nb_threads)
+        -> void
+    {
+        using namespace parallel_merge_sort_detail;
+
+        auto size = std::distance(first, last);
+        if (size < 2) return;
+
+        // Don't spawn threads that wouldn't have anything to do
+        nb_threads = parallel_threads_count(
+            nb_threads,
+            static_cast<std::size_t>(size) / min_chunk_size
+        );
+        if (nb_threads == 1) {
+            merge_sort(std::move(first), std::move(last), size,
+                       std::move(compare), std::move(projection));
+            return;
+        }
+
+        parallel_sort_chunks(
+            std::move(first), std::move(last),
+            std::move(compare), std::move(projection), nb_threads,
+            [](RandomAccessIterator chunk_first, RandomAccessIterator chunk_last,
+               difference_type_t<RandomAccessIterator> chunk_size,
+               Compare chunk_compare, Projection chunk_projection) {
+                merge_sort(std::move(chunk_first), std::move(chunk_last), chunk_size,
+                           std::move(chunk_compare), std::move(chunk_projection));
+            }
+        );
+    }
+}}
+
+#endif // CPPSORT_DETAIL_PARALLEL_MERGE_SORT_H_
@@ -0,0 +1,209 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef CPPSORT_DETAIL_PARALLEL_PDQSORT_H_
+#define CPPSORT_DETAIL_PARALLEL_PDQSORT_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <cpp-sort/utility/as_function.h>
+#include <cpp-sort/utility/branchless_traits.h>
+#include <cpp-sort/utility/iter_move.h>
+#include "bitops.h"
+#include "heapsort.h"
+#include "iter_sort3.h"
+#include "iterator_traits.h"
+#include "pdqsort.h"
+#include "simd.h"
+#include "task_pool.h"
+
+namespace cppsort
+{
+namespace detail
+{
+    namespace parallel_pdqsort_detail
+    {
+        enum {
+            // Partitions below this size are sorted sequentially by the
+            // thread that created them instead of being scheduled
+            sequential_threshold = 8192
+        };
+
+        // Mostly the same as pdqsort_loop, except that the left partition
+        // is scheduled as a new task instead of being recursively sorted,
+        // and that small enough partitions are handed to pdqsort_loop
+        template<typename RandomAccessIterator, typename Compare, typename Projection,
+                 bool Branchless>
+        auto parallel_pdqsort_loop(RandomAccessIterator begin, RandomAccessIterator end,
+                                   Compare compare, Projection projection,
+                                   int bad_allowed, bool leftmost,
+                                   task_group& group)
+            -> void
+        {
+            using namespace pdqsort_detail;
+            using utility::iter_swap;
+            using difference_type = difference_type_t<RandomAccessIterator>;
+            auto&& comp = utility::as_function(compare);
+            auto&& proj = utility::as_function(projection);
+
+            while (true) {
+                difference_type size = std::distance(begin, end);
+
+                // Don't bother splitting the work anymore, also give up
+                // early when another task failed
+                if (size < sequential_threshold || group.has_failed()) {
+                    pdqsort_loop<RandomAccessIterator, Compare, Projection, Branchless>(
+                        std::move(begin), std::move(end),
+                        std::move(compare), std::move(projection),
+                        bad_allowed, leftmost);
+                    return;
+                }
+
+                // Choose pivot as pseudomedian of 9, the partition is
+                // always big enough to use Tukey's ninther
+                difference_type s2 = size / 2;
+                iter_sort3(begin, begin + s2, end - 1, compare, projection);
+                iter_sort3(begin + 1, begin + (s2 - 1), end - 2, compare, projection);
+                iter_sort3(begin + 2, begin + (s2 + 1), end - 3, compare, projection);
+                iter_sort3(begin + (s2 - 1), begin + s2, begin + (s2 + 1), compare, projection);
+                iter_swap(begin, begin + s2);
+
+                // See pdqsort_loop: elements equal to the previous pivot
+                // don't need to be sorted any further
+                if (!leftmost && !comp(proj(*(begin - 1)), proj(*begin))) {
+                    begin = partition_left(begin, end, compare, projection) + 1;
+                    continue;
+                }
+
+                // Partition and get results.
+                std::pair<RandomAccessIterator, bool> part_result = Branchless  ?
+                    partition_right_branchless(begin, end, compare, projection,
+                                               is_simd_partitionable<RandomAccessIterator, Compare, Projection>{}) :
+                    partition_right(begin, end, compare, projection);
+                RandomAccessIterator pivot_pos = part_result.first;
+                bool already_partitioned = part_result.second;
+
+                // Check for a highly unbalanced partition.
+                difference_type l_size = std::distance(begin, pivot_pos);
+                difference_type r_size = std::distance(pivot_pos + 1, end);
+                bool highly_unbalanced = l_size < size / 8 || r_size < size / 8;
+
+                // If we got a highly unbalanced partition we shuffle elements to break many patterns.
+                if (highly_unbalanced) {
+                    // If we had too many bad partitions, switch to heapsort to guarantee O(n log n).
+                    if (--bad_allowed == 0) {
+                        heapsort(std::move(begin), std::move(end),
+                                 std::move(compare), std::move(projection));
+                        return;
+                    }
+
+                    if (l_size >= insertion_sort_threshold) {
+                        iter_swap(begin,             begin + l_size / 4);
+                        iter_swap(pivot_pos - 1, pivot_pos - l_size / 4);
+
+                        if (l_size > ninther_threshold) {
+                            iter_swap(begin + 1,         begin + (l_size / 4 + 1));
+                            iter_swap(begin + 2,         begin + (l_size / 4 + 2));
+                            iter_swap(pivot_pos - 2, pivot_pos - (l_size / 4 + 1));
+                            iter_swap(pivot_pos - 3, pivot_pos - (l_size / 4 + 2));
+                        }
+                    }
+
+                    if (r_size >= insertion_sort_threshold) {
+                        iter_swap(pivot_pos + 1, pivot_pos + (1 + r_size / 4));
+                        iter_swap(end - 1,                   end - r_size / 4);
+
+                        if (r_size > ninther_threshold) {
+                            iter_swap(pivot_pos + 2, pivot_pos + (2 + r_size / 4));
+                            iter_swap(pivot_pos + 3, pivot_pos + (3 + r_size / 4));
+                            iter_swap(end - 2,             end - (1 + r_size / 4));
+                            iter_swap(end - 3,             end - (2 + r_size / 4));
+                        }
+                    }
+                } else {
+                    // If we were decently balanced and we tried to sort an already partitioned
+                    // sequence try to use insertion sort.
+                    if (already_partitioned &&
+                        partial_insertion_sort(begin, pivot_pos, compare, projection) &&
+                        partial_insertion_sort(pivot_pos + 1, end, compare, projection)) {
+                        return;
+                    }
+                }
+
+                // Schedule the left partition as a new task and keep
+                // sorting the right partition in the current thread,
+                // the pivot is already in its final position so that
+                // the tasks never touch the same elements
+                group.run([=, &group] {
+                    parallel_pdqsort_loop<RandomAccessIterator, Compare, Projection, Branchless>(
+                        begin, pivot_pos, compare, projection, bad_allowed, leftmost, group);
+                });
+                begin = pivot_pos + 1;
+                leftmost = false;
+            }
+        }
+    }
+
+    template<typename RandomAccessIterator, typename Compare, typename Projection>
+    auto parallel_pdqsort(RandomAccessIterator begin, RandomAccessIterator end,
+                          Compare compare, Projection projection,
+                          std::size_t nb_threads)
+        -> void
+    {
+        using value_type = value_type_t<RandomAccessIterator>;
+        using projected_type = projected_t<RandomAccessIterator, Projection>;
+        constexpr bool is_branchless =
+            utility::is_probably_branchless_comparison_v<Compare, projected_type> &&
+            utility::is_probably_branchless_projection_v<Projection, value_type>;
+
+        auto size = std::distance(begin, end);
+        if (size < 2) return;
+
+        // Don't spawn threads that wouldn't have anything to do
+        auto nb_chunks = static_cast<std::size_t>(
+            size / parallel_pdqsort_detail::sequential_threshold
+        );
+        nb_threads = parallel_threads_count(nb_threads, nb_chunks);
+        if (nb_threads == 1) {
+            pdqsort(std::move(begin), std::move(end),
+                    std::move(compare), std::move(projection));
+            return;
+        }
+
+        // The current thread takes part in the sort
+        auto& pool = task_pool::shared(nb_threads - 1);
+        task_group group(pool);
+        group.run([&] {
+            parallel_pdqsort_detail::parallel_pdqsort_loop<
+                RandomAccessIterator, Compare, Projection, is_branchless
+            >(begin, end, compare, projection, detail::log2(size), true, group);
+        });
+        group.wait();
+    }
+}}
+
+#endif // CPPSORT_DETAIL_PARALLEL_PDQSORT_H_
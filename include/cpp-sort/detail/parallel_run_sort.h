@@ -0,0 +1,115 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef CPPSORT_DETAIL_PARALLEL_RUN_SORT_H_
+#define CPPSORT_DETAIL_PARALLEL_RUN_SORT_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include "iterator_traits.h"
+#include "parallel_merge_sort.h"
+#include "task_pool.h"
+#include "timsort.h"
+#include "vergesort.h"
+
+namespace cppsort
+{
+namespace detail
+{
+    ////////////////////////////////////////////////////////////
+    // Parallel run-adaptive sorts
+    //
+    // Every thread looks for runs in its own chunk of the collection
+    // and sorts it with the sequential algorithm, the runs crossing
+    // the boundaries between chunks are stitched back together, and
+    // the resulting runs are merged with the same parallel merge
+    // tree as parallel_merge_sort
+
+    template<typename RandomAccessIterator, typename Compare,
+             typename Projection, typename ChunkSorter>
+    auto parallel_run_sort(RandomAccessIterator first, RandomAccessIterator last,
+                           Compare compare, Projection projection,
+                           std::size_t nb_threads, ChunkSorter sort_chunk)
+        -> void
+    {
+        auto size = std::distance(first, last);
+        if (size < 2) return;
+
+        // Don't spawn threads that wouldn't have anything to do
+        nb_threads = parallel_threads_count(
+            nb_threads,
+            static_cast<std::size_t>(size) / parallel_merge_sort_detail::min_chunk_size
+        );
+        if (nb_threads == 1) {
+            sort_chunk(std::move(first), std::move(last), size,
+                       std::move(compare), std::move(projection));
+            return;
+        }
+
+        parallel_sort_chunks(std::move(first), std::move(last),
+                             std::move(compare), std::move(projection),
+                             nb_threads, std::move(sort_chunk));
+    }
+
+    template<typename RandomAccessIterator, typename Compare, typename Projection>
+    auto parallel_timsort(RandomAccessIterator first, RandomAccessIterator last,
+                          Compare compare, Projection projection,
+                          std::size_t nb_threads)
+        -> void
+    {
+        parallel_run_sort(
+            std::move(first), std::move(last),
+            std::move(compare), std::move(projection), nb_threads,
+            [](RandomAccessIterator chunk_first, RandomAccessIterator chunk_last,
+               difference_type_t<RandomAccessIterator>,
+               Compare chunk_compare, Projection chunk_projection) {
+                timsort(std::move(chunk_first), std::move(chunk_last),
+                        std::move(chunk_compare), std::move(chunk_projection));
+            }
+        );
+    }
+
+    template<typename RandomAccessIterator, typename Compare, typename Projection>
+    auto parallel_vergesort(RandomAccessIterator first, RandomAccessIterator last,
+                            Compare compare, Projection projection,
+                            std::size_t nb_threads)
+        -> void
+    {
+        parallel_run_sort(
+            std::move(first), std::move(last),
+            std::move(compare), std::move(projection), nb_threads,
+            [](RandomAccessIterator chunk_first, RandomAccessIterator chunk_last,
+               difference_type_t<RandomAccessIterator>,
+               Compare chunk_compare, Projection chunk_projection) {
+                vergesort(std::move(chunk_first), std::move(chunk_last),
+                          std::move(chunk_compare), std::move(chunk_projection));
+            }
+        );
+    }
+}}
+
+#endif // CPPSORT_DETAIL_PARALLEL_RUN_SORT_H_
@@ -0,0 +1,377 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef CPPSORT_DETAIL_PARALLEL_SKA_SORT_H_
+#define CPPSORT_DETAIL_PARALLEL_SKA_SORT_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <cpp-sort/utility/as_function.h>
+#include <cpp-sort/utility/iter_move.h>
+#include "iterator_traits.h"
+#include "ska_sort.h"
+#include "task_pool.h"
+#include "type_traits.h"
+
+namespace cppsort
+{
+namespace detail
+{
+    namespace parallel_ska_sort_detail
+    {
+        enum {
+            // Buckets below this size are sorted sequentially by
+            // a single task instead of being split further
+            sequential_threshold = 1 << 16,
+
+            // Collections are not split into chunks smaller than
+            // this, the sequential ska_sort is used instead
+            min_chunk_size = 1 << 15
+        };
+
+        // Per-bucket positions of a given thread
+        using bucket_positions = std::array<std::size_t, 256>;
+
+        template<typename CurrentSubKey, std::size_t NumBytes, std::size_t Offset=0>
+        struct parallel_sorter
+        {
+            // Sorts the byte Offset and the following ones of a
+            // single bucket without spawning any task
+            using sequential_sorter = UnsignedInplaceSorter<128, 1024, CurrentSubKey, NumBytes, Offset>;
+
+            template<typename RandomAccessIterator, typename Projection>
+            static auto bucket_of(RandomAccessIterator it, Projection& projection)
+                -> std::uint8_t
+            {
+                auto&& proj = utility::as_function(projection);
+                return sequential_sorter::current_byte(proj(*it), nullptr);
+            }
+
+            // Moves every element of the stripes [begins[b], ends[b]) to
+            // the stripe of its bucket as long as there is room left in
+            // it; the elements that could not be placed are gathered at
+            // the end of their stripe, and heads[b] is left pointing to
+            // the first of them
+            template<typename RandomAccessIterator, typename Projection>
+            static auto permute_stripes(RandomAccessIterator first,
+                                        bucket_positions& heads, const bucket_positions& ends,
+                                        Projection& projection)
+                -> void
+            {
+                using utility::iter_swap;
+                bucket_positions tails = ends;
+
+                for (std::size_t bucket = 0 ; bucket < 256 ; ++bucket) {
+                    while (heads[bucket] < tails[bucket]) {
+                        auto it = first + heads[bucket];
+                        std::size_t target = bucket_of(it, projection);
+                        if (target == bucket) {
+                            ++heads[bucket];
+                        } else if (heads[target] < tails[target]) {
+                            iter_swap(it, first + heads[target]);
+                            ++heads[target];
+                        } else {
+                            --tails[bucket];
+                            iter_swap(it, first + tails[bucket]);
+                        }
+                    }
+                }
+            }
+
+            // Gathers the elements of a bucket that were not placed
+            // by permute_stripes at the end of its unprocessed range,
+            // and returns the new beginning of that range
+            template<typename RandomAccessIterator>
+            static auto repair_bucket(RandomAccessIterator first, std::size_t bucket,
+                                      std::size_t tail, std::size_t nb_stripes,
+                                      const std::vector<bucket_positions>& begins,
+                                      const std::vector<bucket_positions>& heads,
+                                      const std::vector<bucket_positions>& ends)
+                -> std::size_t
+            {
+                using utility::iter_swap;
+
+                std::size_t nb_misplaced = 0;
+                for (std::size_t stripe = 0 ; stripe < nb_stripes ; ++stripe) {
+                    nb_misplaced += ends[stripe][bucket] - heads[stripe][bucket];
+                }
+                std::size_t boundary = tail - nb_misplaced;
+
+                // Swap the misplaced elements found before the boundary
+                // with the placed elements found after it
+                std::size_t low_stripe = 0;
+                std::size_t low = heads[0][bucket];
+                std::size_t high_stripe = 0;
+                std::size_t high = std::max(begins[0][bucket], boundary);
+                while (true) {
+                    while (low >= ends[low_stripe][bucket] && low < boundary) {
+                        ++low_stripe;
+                        low = heads[low_stripe][bucket];
+                    }
+                    if (low >= boundary) break;
+
+                    while (high >= heads[high_stripe][bucket]) {
+                        ++high_stripe;
+                        high = std::max(begins[high_stripe][bucket], boundary);
+                    }
+                    iter_swap(first + low, first + high);
+                    ++low;
+                    ++high;
+                }
+                return boundary;
+            }
+
+            template<typename RandomAccessIterator, typename Projection>
+            static auto sort(RandomAccessIterator first, std::size_t size, Projection projection,
+                             std::size_t nb_threads, task_pool& pool, task_group& buckets_group)
+                -> void
+            {
+                // There is no next sub-key to sort for the handled keys
+                using sort_type = void (*)(RandomAccessIterator, RandomAccessIterator,
+                                           std::ptrdiff_t, Projection, void*);
+
+                if (size < sequential_threshold || buckets_group.has_failed()) {
+                    sequential_sorter::sort(first, first + size, static_cast<std::ptrdiff_t>(size),
+                                            std::move(projection),
+                                            sort_type(nullptr), nullptr);
+                    return;
+                }
+
+                // The barriers of this step can't wait on buckets_group,
+                // which would wait for every bucket of the whole sort
+                task_group group(pool);
+                std::size_t nb_tasks = parallel_threads_count(nb_threads, size / min_chunk_size);
+
+                ////////////////////////////////////////////////////////////
+                // Parallel histogram
+
+                std::vector<bucket_positions> counts(nb_tasks, bucket_positions{});
+                for (std::size_t task = 0 ; task < nb_tasks ; ++task) {
+                    group.run([&, task] {
+                        auto it = first + task * size / nb_tasks;
+                        auto end = first + (task + 1) * size / nb_tasks;
+                        for (; it != end ; ++it) {
+                            ++counts[task][bucket_of(it, projection)];
+                        }
+                    });
+                }
+                group.wait();
+
+                bucket_positions heads;
+                bucket_positions tails;
+                std::size_t total = 0;
+                for (std::size_t bucket = 0 ; bucket < 256 ; ++bucket) {
+                    heads[bucket] = total;
+                    for (std::size_t task = 0 ; task < nb_tasks ; ++task) {
+                        total += counts[task][bucket];
+                    }
+                    tails[bucket] = total;
+
+                    if (tails[bucket] - heads[bucket] == size) {
+                        // Every element has the same byte, no need
+                        // to move anything around
+                        parallel_sorter<CurrentSubKey, NumBytes, Offset + 1>::sort(
+                            first, size, std::move(projection),
+                            nb_threads, pool, buckets_group
+                        );
+                        return;
+                    }
+                }
+
+                ////////////////////////////////////////////////////////////
+                // Parallel in-place permutation
+
+                // The unprocessed part of every bucket is split into one
+                // stripe per task, and each task moves the elements of its
+                // stripes to its own stripes; the elements that could not
+                // be placed are gathered and the process is repeated with
+                // what remains. With a single stripe per bucket, every
+                // element finds a place: we use that to finish the job when
+                // too few elements are left or when no progress was made
+
+                std::vector<bucket_positions> stripe_begins(nb_tasks);
+                std::vector<bucket_positions> stripe_heads(nb_tasks);
+                std::vector<bucket_positions> stripe_ends(nb_tasks);
+                std::size_t remaining = size;
+                std::size_t nb_stripes = nb_tasks;
+                while (remaining > 0) {
+                    if (remaining < sequential_threshold) {
+                        nb_stripes = 1;
+                    }
+
+                    for (std::size_t stripe = 0 ; stripe < nb_stripes ; ++stripe) {
+                        for (std::size_t bucket = 0 ; bucket < 256 ; ++bucket) {
+                            std::size_t length = tails[bucket] - heads[bucket];
+                            stripe_begins[stripe][bucket] = heads[bucket] + stripe * length / nb_stripes;
+                            stripe_ends[stripe][bucket] = heads[bucket] + (stripe + 1) * length / nb_stripes;
+                        }
+                        stripe_heads[stripe] = stripe_begins[stripe];
+                    }
+
+                    if (nb_stripes == 1) {
+                        permute_stripes(first, stripe_heads[0], stripe_ends[0], projection);
+                        break;
+                    }
+
+                    for (std::size_t stripe = 0 ; stripe < nb_stripes ; ++stripe) {
+                        group.run([&, stripe] {
+                            permute_stripes(first, stripe_heads[stripe], stripe_ends[stripe],
+                                            projection);
+                        });
+                    }
+                    group.wait();
+
+                    for (std::size_t bucket = 0 ; bucket < 256 ; ++bucket) {
+                        if (heads[bucket] == tails[bucket]) continue;
+                        group.run([&, bucket] {
+                            heads[bucket] = repair_bucket(first, bucket, tails[bucket], nb_stripes,
+                                                          stripe_begins, stripe_heads, stripe_ends);
+                        });
+                    }
+                    group.wait();
+
+                    std::size_t new_remaining = 0;
+                    for (std::size_t bucket = 0 ; bucket < 256 ; ++bucket) {
+                        new_remaining += tails[bucket] - heads[bucket];
+                    }
+                    if (new_remaining == remaining) {
+                        nb_stripes = 1;
+                    }
+                    remaining = new_remaining;
+                }
+
+                ////////////////////////////////////////////////////////////
+                // Dispatch the buckets to the worker threads
+
+                if (Offset + 1 == NumBytes) return;
+
+                std::size_t begin = 0;
+                for (std::size_t bucket = 0 ; bucket < 256 ; ++bucket) {
+                    std::size_t end = tails[bucket];
+                    std::size_t bucket_size = end - begin;
+                    auto bucket_first = first + begin;
+                    if (bucket_size >= sequential_threshold) {
+                        buckets_group.run([=, &pool, &buckets_group] {
+                            parallel_sorter<CurrentSubKey, NumBytes, Offset + 1>::sort(
+                                bucket_first, bucket_size, projection,
+                                nb_threads, pool, buckets_group
+                            );
+                        });
+                    } else if (bucket_size > 1) {
+                        buckets_group.run([=] {
+                            sequential_sorter::sort_partition(
+                                bucket_first, bucket_first + bucket_size,
+                                static_cast<std::ptrdiff_t>(bucket_size),
+                                projection, sort_type(nullptr), nullptr
+                            );
+                        });
+                    }
+                    begin = end;
+                }
+            }
+        };
+
+        template<typename CurrentSubKey, std::size_t NumBytes>
+        struct parallel_sorter<CurrentSubKey, NumBytes, NumBytes>
+        {
+            template<typename RandomAccessIterator, typename Projection>
+            static auto sort(RandomAccessIterator, std::size_t, Projection,
+                             std::size_t, task_pool&, task_group&)
+                -> void
+            {
+                // Every byte was already handled
+            }
+        };
+
+        // Only the keys that ska_sort maps to a single unsigned integer
+        // are handled in parallel, the composite keys (pairs, tuples,
+        // strings...) are sorted sequentially
+        template<typename CurrentSubKey>
+        struct is_parallel_sortable:
+            std::integral_constant<bool,
+                is_unsigned<typename CurrentSubKey::sub_key_type>::value &&
+                not std::is_same<typename CurrentSubKey::sub_key_type, bool>::value &&
+                std::is_same<typename CurrentSubKey::next, SubKey<void>>::value
+            >
+        {};
+
+        template<typename RandomAccessIterator, typename Projection>
+        auto parallel_ska_sort(RandomAccessIterator first, RandomAccessIterator last,
+                               Projection projection, std::size_t nb_threads,
+                               std::false_type /* is_parallel_sortable */)
+            -> void
+        {
+            (void) nb_threads;
+            ska_sort(std::move(first), std::move(last), std::move(projection));
+        }
+
+        template<typename RandomAccessIterator, typename Projection>
+        auto parallel_ska_sort(RandomAccessIterator first, RandomAccessIterator last,
+                               Projection projection, std::size_t nb_threads,
+                               std::true_type /* is_parallel_sortable */)
+            -> void
+        {
+            using sub_key = SubKey<projected_t<RandomAccessIterator, Projection>>;
+            using sorter = parallel_sorter<sub_key, sizeof(typename sub_key::sub_key_type)>;
+
+            auto size = static_cast<std::size_t>(std::distance(first, last));
+
+            // Don't spawn threads that wouldn't have anything to do
+            nb_threads = parallel_threads_count(nb_threads, size / min_chunk_size);
+            if (nb_threads == 1) {
+                ska_sort(std::move(first), std::move(last), std::move(projection));
+                return;
+            }
+
+            // The current thread takes part in the sort
+            auto& pool = task_pool::shared(nb_threads - 1);
+            task_group group(pool);
+            sorter::sort(first, size, std::move(projection), nb_threads, pool, group);
+            group.wait();
+        }
+    }
+
+    template<typename RandomAccessIterator, typename Projection>
+    auto parallel_ska_sort(RandomAccessIterator first, RandomAccessIterator last,
+                           Projection projection, std::size_t nb_threads)
+        -> void
+    {
+        using sub_key = SubKey<projected_t<RandomAccessIterator, Projection>>;
+        parallel_ska_sort_detail::parallel_ska_sort(
+            std::move(first), std::move(last),
+            std::move(projection), nb_threads,
+            parallel_ska_sort_detail::is_parallel_sortable<sub_key>{}
+        );
+    }
+}}
+
+#endif // CPPSORT_DETAIL_PARALLEL_SKA_SORT_H_
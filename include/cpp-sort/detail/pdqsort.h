@@ -27,7 +27,10 @@
 ////////////////////////////////////////////////////////////
 #include <algorithm>
 #include <cstddef>
+#include <functional>
 #include <iterator>
+#include <memory>
+#include <type_traits>
 #include <utility>
 #include <cpp-sort/utility/as_function.h>
 #include <cpp-sort/utility/branchless_traits.h>
@@ -37,6 +40,9 @@
 #include "insertion_sort.h"
 #include "iterator_traits.h"
 #include "iter_sort3.h"
+#include "network_sort.h"
+#include "simd.h"
+#include "simd_partition.h"
 
 #ifdef __MINGW32__
 #   include <cstdint> // std::uintptr_t
@@ -342,6 +348,64 @@ namespace detail
             return std::make_pair(pivot_pos, already_partitioned);
         }
 
+        template<typename RandomAccessIterator, typename Compare, typename Projection>
+        auto partition_right_branchless(RandomAccessIterator begin, RandomAccessIterator end,
+                                        Compare compare, Projection projection,
+                                        std::false_type /* vectorized */)
+            -> std::pair<RandomAccessIterator, bool>
+        {
+            return partition_right_branchless(std::move(begin), std::move(end),
+                                              std::move(compare), std::move(projection));
+        }
+
+#ifdef CPPSORT_X86_SIMD
+        // Same as partition_right_branchless for contiguous collections of arithmetic types compared
+        // with the default comparisons: once the elements already on the correct side have been
+        // skipped, the rest of the range is partitioned with vector instructions when the CPU
+        // supports them.
+        template<typename RandomAccessIterator, typename Compare, typename Projection>
+        auto partition_right_branchless(RandomAccessIterator begin, RandomAccessIterator end,
+                                        Compare compare, Projection projection,
+                                        std::true_type /* vectorized */)
+            -> std::pair<RandomAccessIterator, bool>
+        {
+            if (not cpu_supports_avx2()) {
+                return partition_right_branchless(std::move(begin), std::move(end),
+                                                  std::move(compare), std::move(projection));
+            }
+
+            using value_type = value_type_t<RandomAccessIterator>;
+            constexpr bool descending = std::is_same<Compare, std::greater<>>::value;
+            auto&& comp = utility::as_function(compare);
+
+            value_type pivot = *begin;
+            RandomAccessIterator first = begin;
+            RandomAccessIterator last = end;
+
+            // Same as partition_right_branchless
+            while (comp(*++first, pivot));
+            if (first - 1 == begin) while (first < last && !comp(*--last, pivot));
+            else                    while (                !comp(*--last, pivot));
+
+            bool already_partitioned = first >= last;
+            if (!already_partitioned) {
+                // *first and *last are both on the wrong side
+                value_type* ptr = std::addressof(*begin);
+                value_type* middle = simd_partition<descending>(ptr + (first - begin),
+                                                                ptr + (last - begin) + 1,
+                                                                pivot);
+                first = begin + (middle - ptr);
+            }
+
+            // Put the pivot in the right place.
+            RandomAccessIterator pivot_pos = first - 1;
+            *begin = *pivot_pos;
+            *pivot_pos = pivot;
+
+            return std::make_pair(pivot_pos, already_partitioned);
+        }
+#endif
+
         // Partitions [begin, end) around pivot *begin using comparison function compare. Elements equal
         // to the pivot are put in the right-hand partition. Returns the position of the pivot after
         // partitioning and whether the passed sequence already was correctly partitioned. Assumes the
@@ -446,8 +510,12 @@ namespace detail
             while (true) {
                 difference_type size = std::distance(begin, end);
 
-                // Insertion sort is faster for small arrays.
+                // Insertion sort is faster for small arrays, unless
+                // branchless sorting networks can be used instead.
                 if (size < insertion_sort_threshold) {
+                    if (try_network_sort(begin, end, compare, projection)) {
+                        return;
+                    }
                     if (leftmost) {
                         insertion_sort(begin, end, std::move(compare), std::move(projection));
                     } else {
@@ -480,7 +548,8 @@ namespace detail
 
                 // Partition and get results.
                 std::pair<RandomAccessIterator, bool> part_result = Branchless  ?
-                    partition_right_branchless(begin, end, compare, projection) :
+                    partition_right_branchless(begin, end, compare, projection,
+                                               is_simd_partitionable<RandomAccessIterator, Compare, Projection>{}) :
                     partition_right(begin, end, compare, projection);
                 RandomAccessIterator pivot_pos = part_result.first;
                 bool already_partitioned = part_result.second;
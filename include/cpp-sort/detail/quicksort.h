@@ -36,6 +36,7 @@
 #include "insertion_sort.h"
 #include "introselect.h"
 #include "iterator_traits.h"
+#include "network_sort.h"
 #include "partition.h"
 
 namespace cppsort
@@ -75,6 +76,21 @@ namespace detail
         return false;
     }
 
+    template<typename RandomAccessIterator, typename Compare, typename Projection>
+    auto quicksort_fallback(RandomAccessIterator first, RandomAccessIterator last,
+                            difference_type_t<RandomAccessIterator> size,
+                            Compare compare, Projection projection,
+                            std::random_access_iterator_tag)
+        -> bool
+    {
+        if (try_network_sort(first, last, compare, projection)) {
+            return true;
+        }
+        return quicksort_fallback(std::move(first), std::move(last), size,
+                                  std::move(compare), std::move(projection),
+                                  std::bidirectional_iterator_tag{});
+    }
+
     template<typename ForwardIterator, typename Compare, typename Projection>
     auto quicksort(ForwardIterator first, ForwardIterator last,
                    difference_type_t<ForwardIterator> size, int bad_allowed,
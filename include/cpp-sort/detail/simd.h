@@ -0,0 +1,174 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef CPPSORT_DETAIL_SIMD_H_
+#define CPPSORT_DETAIL_SIMD_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <functional>
+#include <type_traits>
+#include <vector>
+#include <cpp-sort/utility/functional.h>
+#include "iterator_traits.h"
+#include "type_traits.h"
+
+////////////////////////////////////////////////////////////
+// CPPSORT_X86_SIMD
+
+// Vectorized algorithms are compiled for specific instruction
+// sets with function-level target attributes and selected at
+// runtime depending on what the CPU supports, which means that
+// they can be used without compiling the whole program with
+// -mavx2 or similar flags; defining CPPSORT_DISABLE_SIMD
+// disables them altogether
+
+#if !defined(CPPSORT_DISABLE_SIMD) && (defined(__GNUC__) || defined(__clang__)) \
+    && (defined(__x86_64__) || defined(__i386__))
+#   define CPPSORT_X86_SIMD
+#   define CPPSORT_TARGET_AVX2 __attribute__((target("avx2")))
+#   define CPPSORT_TARGET_AVX512 __attribute__((target("avx512f")))
+#   include <immintrin.h>
+#endif
+
+namespace cppsort
+{
+namespace detail
+{
+    ////////////////////////////////////////////////////////////
+    // Runtime CPU features detection
+
+#ifdef CPPSORT_X86_SIMD
+    constexpr bool has_simd_algorithms = true;
+
+    inline auto cpu_supports_avx2() noexcept
+        -> bool
+    {
+        return __builtin_cpu_supports("avx2");
+    }
+
+    inline auto cpu_supports_avx512() noexcept
+        -> bool
+    {
+        return __builtin_cpu_supports("avx512f");
+    }
+#else
+    constexpr bool has_simd_algorithms = false;
+
+    constexpr auto cpu_supports_avx2() noexcept
+        -> bool
+    {
+        return false;
+    }
+
+    constexpr auto cpu_supports_avx512() noexcept
+        -> bool
+    {
+        return false;
+    }
+#endif
+
+    ////////////////////////////////////////////////////////////
+    // Iterators over contiguous memory
+
+    // There is no way to detect contiguous iterators in C++14,
+    // so only pointers and std::vector iterators are handled
+
+    template<typename Iterator>
+    struct is_contiguous_iterator:
+        std::integral_constant<bool,
+            std::is_pointer<Iterator>::value ||
+            std::is_same<
+                Iterator,
+                typename std::vector<value_type_t<Iterator>>::iterator
+            >::value
+        >
+    {};
+
+    template<>
+    struct is_contiguous_iterator<std::vector<bool>::iterator>:
+        std::false_type
+    {};
+
+    ////////////////////////////////////////////////////////////
+    // Types handled by the vectorized algorithms
+
+    // Signed integers of 32 and 64 bits, float and double, only
+    // sorted with the default comparisons and no projection
+
+    template<typename T>
+    struct is_simd_arithmetic:
+        std::integral_constant<bool,
+            (std::is_integral<T>::value && std::is_signed<T>::value &&
+             (sizeof(T) == 4 || sizeof(T) == 8)) ||
+            std::is_same<T, float>::value ||
+            std::is_same<T, double>::value
+        >
+    {};
+
+    template<typename Compare>
+    struct is_simd_comparison:
+        std::integral_constant<bool,
+            std::is_same<Compare, std::less<>>::value ||
+            std::is_same<Compare, std::greater<>>::value
+        >
+    {};
+
+    template<typename Iterator, typename Compare, typename Projection>
+    struct is_simd_sortable:
+        conjunction<
+            std::integral_constant<bool, has_simd_algorithms>,
+            is_simd_arithmetic<value_type_t<Iterator>>,
+            is_simd_comparison<Compare>,
+            std::is_same<Projection, utility::identity>,
+            is_contiguous_iterator<Iterator>
+        >
+    {};
+
+    // Partitioning only needs comparisons, which can also be
+    // vectorized for unsigned integers
+
+    template<typename T>
+    struct is_simd_partition_arithmetic:
+        std::integral_constant<bool,
+            (std::is_integral<T>::value && not std::is_same<T, bool>::value &&
+             (sizeof(T) == 4 || sizeof(T) == 8)) ||
+            std::is_same<T, float>::value ||
+            std::is_same<T, double>::value
+        >
+    {};
+
+    template<typename Iterator, typename Compare, typename Projection>
+    struct is_simd_partitionable:
+        conjunction<
+            std::integral_constant<bool, has_simd_algorithms>,
+            is_simd_partition_arithmetic<value_type_t<Iterator>>,
+            is_simd_comparison<Compare>,
+            std::is_same<Projection, utility::identity>,
+            is_contiguous_iterator<Iterator>
+        >
+    {};
+}}
+
+#endif // CPPSORT_DETAIL_SIMD_H_
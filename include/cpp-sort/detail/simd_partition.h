@@ -0,0 +1,758 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef CPPSORT_DETAIL_SIMD_PARTITION_H_
+#define CPPSORT_DETAIL_SIMD_PARTITION_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstdint>
+#include <type_traits>
+#include <cpp-sort/utility/static_const.h>
+#include "simd.h"
+
+namespace cppsort
+{
+namespace detail
+{
+#ifdef CPPSORT_X86_SIMD
+    namespace simd_partition_detail
+    {
+        ////////////////////////////////////////////////////////////
+        // Permutation table for AVX2
+
+        // AVX2 doesn't have a compress instruction: the partition of a
+        // vector is a permutation whose indices are computed from the
+        // comparison mask, the lanes whose bit is set going first; the
+        // indices of the eight 32-bit lanes are packed in nibbles
+        template<int Lanes>
+        struct compress_indices_table
+        {
+            std::uint32_t values[1 << Lanes];
+
+            constexpr compress_indices_table() noexcept:
+                values{}
+            {
+                // Number of 32-bit lanes per element
+                constexpr int width = 8 / Lanes;
+
+                for (int mask = 0 ; mask < (1 << Lanes) ; ++mask) {
+                    std::uint32_t indices = 0;
+                    int pos = 0;
+                    for (int bit = 1 ; bit >= 0 ; --bit) {
+                        for (int lane = 0 ; lane < Lanes ; ++lane) {
+                            if (((mask >> lane) & 1) != bit) continue;
+                            for (int idx = 0 ; idx < width ; ++idx) {
+                                indices |= static_cast<std::uint32_t>(lane * width + idx) << (4 * pos);
+                                ++pos;
+                            }
+                        }
+                    }
+                    values[mask] = indices;
+                }
+            }
+        };
+
+        template<int Lanes>
+        CPPSORT_TARGET_AVX2
+        auto compress_indices(int mask) noexcept
+            -> __m256i
+        {
+            auto&& table = utility::static_const<compress_indices_table<Lanes>>::value;
+            auto indices = _mm256_set1_epi32(static_cast<int>(table.values[mask]));
+            // Only the three lowest bits are used by the permutation
+            return _mm256_srlv_epi32(indices, _mm256_setr_epi32(0, 4, 8, 12, 16, 20, 24, 28));
+        }
+
+        ////////////////////////////////////////////////////////////
+        // Vector operations for every handled type
+
+        // greater_mask(lhs, rhs) returns a bitmask whose bit i is set
+        // when the lane i of lhs is greater than the lane i of rhs;
+        // unsigned integers are compared as signed integers after
+        // flipping their sign bit
+
+        template<typename T, typename=void>
+        struct avx2_ops;
+
+        template<>
+        struct avx2_ops<float>
+        {
+            using vector_type = __m256;
+            static constexpr int lanes = 8;
+
+            CPPSORT_TARGET_AVX2
+            static auto broadcast(float value) noexcept
+                -> __m256
+            {
+                return _mm256_set1_ps(value);
+            }
+
+            CPPSORT_TARGET_AVX2
+            static auto load(const float* ptr) noexcept
+                -> __m256
+            {
+                return _mm256_loadu_ps(ptr);
+            }
+
+            CPPSORT_TARGET_AVX2
+            static auto store(float* ptr, __m256 vec) noexcept
+                -> void
+            {
+                _mm256_storeu_ps(ptr, vec);
+            }
+
+            CPPSORT_TARGET_AVX2
+            static auto greater_mask(__m256 lhs, __m256 rhs) noexcept
+                -> int
+            {
+                return _mm256_movemask_ps(_mm256_cmp_ps(lhs, rhs, _CMP_GT_OQ));
+            }
+
+            CPPSORT_TARGET_AVX2
+            static auto compress(__m256 vec, int mask) noexcept
+                -> __m256
+            {
+                return _mm256_permutevar8x32_ps(vec, compress_indices<lanes>(mask));
+            }
+        };
+
+        template<>
+        struct avx2_ops<double>
+        {
+            using vector_type = __m256d;
+            static constexpr int lanes = 4;
+
+            CPPSORT_TARGET_AVX2
+            static auto broadcast(double value) noexcept
+                -> __m256d
+            {
+                return _mm256_set1_pd(value);
+            }
+
+            CPPSORT_TARGET_AVX2
+            static auto load(const double* ptr) noexcept
+                -> __m256d
+            {
+                return _mm256_loadu_pd(ptr);
+            }
+
+            CPPSORT_TARGET_AVX2
+            static auto store(double* ptr, __m256d vec) noexcept
+                -> void
+            {
+                _mm256_storeu_pd(ptr, vec);
+            }
+
+            CPPSORT_TARGET_AVX2
+            static auto greater_mask(__m256d lhs, __m256d rhs) noexcept
+                -> int
+            {
+                return _mm256_movemask_pd(_mm256_cmp_pd(lhs, rhs, _CMP_GT_OQ));
+            }
+
+            CPPSORT_TARGET_AVX2
+            static auto compress(__m256d vec, int mask) noexcept
+                -> __m256d
+            {
+                return _mm256_castps_pd(_mm256_permutevar8x32_ps(
+                    _mm256_castpd_ps(vec), compress_indices<lanes>(mask)
+                ));
+            }
+        };
+
+        template<typename T>
+        struct avx2_ops<T, std::enable_if_t<std::is_integral<T>::value && sizeof(T) == 4>>
+        {
+            using vector_type = __m256i;
+            static constexpr int lanes = 8;
+
+            CPPSORT_TARGET_AVX2
+            static auto broadcast(T value) noexcept
+                -> __m256i
+            {
+                return _mm256_set1_epi32(static_cast<int>(value));
+            }
+
+            CPPSORT_TARGET_AVX2
+            static auto load(const T* ptr) noexcept
+                -> __m256i
+            {
+                return _mm256_loadu_si256(static_cast<const __m256i*>(static_cast<const void*>(ptr)));
+            }
+
+            CPPSORT_TARGET_AVX2
+            static auto store(T* ptr, __m256i vec) noexcept
+                -> void
+            {
+                _mm256_storeu_si256(static_cast<__m256i*>(static_cast<void*>(ptr)), vec);
+            }
+
+            CPPSORT_TARGET_AVX2
+            static auto greater_mask(__m256i lhs, __m256i rhs) noexcept
+                -> int
+            {
+                if (std::is_unsigned<T>::value) {
+                    auto sign = _mm256_set1_epi32(static_cast<int>(0x80000000u));
+                    lhs = _mm256_xor_si256(lhs, sign);
+                    rhs = _mm256_xor_si256(rhs, sign);
+                }
+                return _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(lhs, rhs)));
+            }
+
+            CPPSORT_TARGET_AVX2
+            static auto compress(__m256i vec, int mask) noexcept
+                -> __m256i
+            {
+                return _mm256_permutevar8x32_epi32(vec, compress_indices<lanes>(mask));
+            }
+        };
+
+        template<typename T>
+        struct avx2_ops<T, std::enable_if_t<std::is_integral<T>::value && sizeof(T) == 8>>
+        {
+            using vector_type = __m256i;
+            static constexpr int lanes = 4;
+
+            CPPSORT_TARGET_AVX2
+            static auto broadcast(T value) noexcept
+                -> __m256i
+            {
+                return _mm256_set1_epi64x(static_cast<long long>(value));
+            }
+
+            CPPSORT_TARGET_AVX2
+            static auto load(const T* ptr) noexcept
+                -> __m256i
+            {
+                return _mm256_loadu_si256(static_cast<const __m256i*>(static_cast<const void*>(ptr)));
+            }
+
+            CPPSORT_TARGET_AVX2
+            static auto store(T* ptr, __m256i vec) noexcept
+                -> void
+            {
+                _mm256_storeu_si256(static_cast<__m256i*>(static_cast<void*>(ptr)), vec);
+            }
+
+            CPPSORT_TARGET_AVX2
+            static auto greater_mask(__m256i lhs, __m256i rhs) noexcept
+                -> int
+            {
+                if (std::is_unsigned<T>::value) {
+                    auto sign = _mm256_set1_epi64x(static_cast<long long>(0x8000000000000000u));
+                    lhs = _mm256_xor_si256(lhs, sign);
+                    rhs = _mm256_xor_si256(rhs, sign);
+                }
+                return _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(lhs, rhs)));
+            }
+
+            CPPSORT_TARGET_AVX2
+            static auto compress(__m256i vec, int mask) noexcept
+                -> __m256i
+            {
+                return _mm256_permutevar8x32_epi32(vec, compress_indices<lanes>(mask));
+            }
+        };
+
+        // AVX-512 has proper compress instructions and masked stores,
+        // which spares the permutation table; compress(vec, mask)
+        // packs the lanes whose bit is set at the beginning of the
+        // vector and zeroes the others
+
+        template<typename T, typename=void>
+        struct avx512_ops;
+
+        template<>
+        struct avx512_ops<float>
+        {
+            using vector_type = __m512;
+            using mask_type = __mmask16;
+            static constexpr int lanes = 16;
+
+            CPPSORT_TARGET_AVX512
+            static auto broadcast(float value) noexcept
+                -> __m512
+            {
+                return _mm512_set1_ps(value);
+            }
+
+            CPPSORT_TARGET_AVX512
+            static auto load(const float* ptr) noexcept
+                -> __m512
+            {
+                return _mm512_loadu_ps(ptr);
+            }
+
+            CPPSORT_TARGET_AVX512
+            static auto store(float* ptr, __m512 vec) noexcept
+                -> void
+            {
+                _mm512_storeu_ps(ptr, vec);
+            }
+
+            CPPSORT_TARGET_AVX512
+            static auto store(float* ptr, __mmask16 mask, __m512 vec) noexcept
+                -> void
+            {
+                _mm512_mask_storeu_ps(ptr, mask, vec);
+            }
+
+            CPPSORT_TARGET_AVX512
+            static auto greater_mask(__m512 lhs, __m512 rhs) noexcept
+                -> __mmask16
+            {
+                return _mm512_cmp_ps_mask(lhs, rhs, _CMP_GT_OQ);
+            }
+
+            CPPSORT_TARGET_AVX512
+            static auto compress(__m512 vec, __mmask16 mask) noexcept
+                -> __m512
+            {
+                return _mm512_maskz_compress_ps(mask, vec);
+            }
+        };
+
+        template<>
+        struct avx512_ops<double>
+        {
+            using vector_type = __m512d;
+            using mask_type = __mmask8;
+            static constexpr int lanes = 8;
+
+            CPPSORT_TARGET_AVX512
+            static auto broadcast(double value) noexcept
+                -> __m512d
+            {
+                return _mm512_set1_pd(value);
+            }
+
+            CPPSORT_TARGET_AVX512
+            static auto load(const double* ptr) noexcept
+                -> __m512d
+            {
+                return _mm512_loadu_pd(ptr);
+            }
+
+            CPPSORT_TARGET_AVX512
+            static auto store(double* ptr, __m512d vec) noexcept
+                -> void
+            {
+                _mm512_storeu_pd(ptr, vec);
+            }
+
+            CPPSORT_TARGET_AVX512
+            static auto store(double* ptr, __mmask8 mask, __m512d vec) noexcept
+                -> void
+            {
+                _mm512_mask_storeu_pd(ptr, mask, vec);
+            }
+
+            CPPSORT_TARGET_AVX512
+            static auto greater_mask(__m512d lhs, __m512d rhs) noexcept
+                -> __mmask8
+            {
+                return _mm512_cmp_pd_mask(lhs, rhs, _CMP_GT_OQ);
+            }
+
+            CPPSORT_TARGET_AVX512
+            static auto compress(__m512d vec, __mmask8 mask) noexcept
+                -> __m512d
+            {
+                return _mm512_maskz_compress_pd(mask, vec);
+            }
+        };
+
+        template<typename T>
+        struct avx512_ops<T, std::enable_if_t<std::is_integral<T>::value && sizeof(T) == 4>>
+        {
+            using vector_type = __m512i;
+            using mask_type = __mmask16;
+            static constexpr int lanes = 16;
+
+            CPPSORT_TARGET_AVX512
+            static auto broadcast(T value) noexcept
+                -> __m512i
+            {
+                return _mm512_set1_epi32(static_cast<int>(value));
+            }
+
+            CPPSORT_TARGET_AVX512
+            static auto load(const T* ptr) noexcept
+                -> __m512i
+            {
+                return _mm512_loadu_si512(ptr);
+            }
+
+            CPPSORT_TARGET_AVX512
+            static auto store(T* ptr, __m512i vec) noexcept
+                -> void
+            {
+                _mm512_storeu_si512(ptr, vec);
+            }
+
+            CPPSORT_TARGET_AVX512
+            static auto store(T* ptr, __mmask16 mask, __m512i vec) noexcept
+                -> void
+            {
+                _mm512_mask_storeu_epi32(ptr, mask, vec);
+            }
+
+            CPPSORT_TARGET_AVX512
+            static auto greater_mask(__m512i lhs, __m512i rhs) noexcept
+                -> __mmask16
+            {
+                return std::is_unsigned<T>::value ?
+                    _mm512_cmpgt_epu32_mask(lhs, rhs) :
+                    _mm512_cmpgt_epi32_mask(lhs, rhs);
+            }
+
+            CPPSORT_TARGET_AVX512
+            static auto compress(__m512i vec, __mmask16 mask) noexcept
+                -> __m512i
+            {
+                return _mm512_maskz_compress_epi32(mask, vec);
+            }
+        };
+
+        template<typename T>
+        struct avx512_ops<T, std::enable_if_t<std::is_integral<T>::value && sizeof(T) == 8>>
+        {
+            using vector_type = __m512i;
+            using mask_type = __mmask8;
+            static constexpr int lanes = 8;
+
+            CPPSORT_TARGET_AVX512
+            static auto broadcast(T value) noexcept
+                -> __m512i
+            {
+                return _mm512_set1_epi64(static_cast<long long>(value));
+            }
+
+            CPPSORT_TARGET_AVX512
+            static auto load(const T* ptr) noexcept
+                -> __m512i
+            {
+                return _mm512_loadu_si512(ptr);
+            }
+
+            CPPSORT_TARGET_AVX512
+            static auto store(T* ptr, __m512i vec) noexcept
+                -> void
+            {
+                _mm512_storeu_si512(ptr, vec);
+            }
+
+            CPPSORT_TARGET_AVX512
+            static auto store(T* ptr, __mmask8 mask, __m512i vec) noexcept
+                -> void
+            {
+                _mm512_mask_storeu_epi64(ptr, mask, vec);
+            }
+
+            CPPSORT_TARGET_AVX512
+            static auto greater_mask(__m512i lhs, __m512i rhs) noexcept
+                -> __mmask8
+            {
+                return std::is_unsigned<T>::value ?
+                    _mm512_cmpgt_epu64_mask(lhs, rhs) :
+                    _mm512_cmpgt_epi64_mask(lhs, rhs);
+            }
+
+            CPPSORT_TARGET_AVX512
+            static auto compress(__m512i vec, __mmask8 mask) noexcept
+                -> __m512i
+            {
+                return _mm512_maskz_compress_epi64(mask, vec);
+            }
+        };
+
+        ////////////////////////////////////////////////////////////
+        // Scalar helpers
+
+        // Number of vectors read at once from either side of the
+        // collection by the vectorized algorithms, the loops reading
+        // them are manually unrolled
+        constexpr int unroll = 4;
+
+        template<bool Descending, typename T>
+        auto goes_left(T value, T pivot) noexcept
+            -> bool
+        {
+            return Descending ? pivot < value : value < pivot;
+        }
+
+        // Partitions ranges too small for the vectorized algorithms
+        // with a branchless variant of Lomuto's partition scheme: the
+        // elements in [middle, it) belong to the right partition, so
+        // swapping *it with *middle keeps that invariant even when
+        // *it belongs to the right partition too
+        template<bool Descending, typename T>
+        auto small_partition(T* first, T* last, T pivot) noexcept
+            -> T*
+        {
+            T* middle = first;
+            for (T* it = first ; it != last ; ++it) {
+                T value = *it;
+                bool left = goes_left<Descending>(value, pivot);
+                *it = *middle;
+                *middle = value;
+                middle += left;
+            }
+            return middle;
+        }
+
+        // Partitions the elements remaining between the read pointers
+        // once there isn't enough of them to fill a vector; reading
+        // from the side with the least free room guarantees that both
+        // sides have room left to write the element
+        template<bool Descending, typename T>
+        auto partition_remaining(T*& read_left, T*& read_right,
+                                 T*& write_left, T*& write_right,
+                                 T pivot) noexcept
+            -> void
+        {
+            while (read_left < read_right) {
+                T value = (read_left - write_left <= write_right - read_right) ?
+                    *read_left++ :
+                    *--read_right;
+                if (goes_left<Descending>(value, pivot)) {
+                    *write_left++ = value;
+                } else {
+                    *--write_right = value;
+                }
+            }
+        }
+
+        ////////////////////////////////////////////////////////////
+        // Vectorized partitioning
+
+        // The algorithm is the one described in "Fast Quicksort
+        // Implementation Using AVX Instructions" by Shay Gueron and
+        // Vlad Krasnov: the first and last elements of the range are
+        // copied to a buffer, which frees room at both ends of the
+        // range, then the vectors read from the side with the least
+        // free room are partitioned and their elements are written to
+        // the free room on both sides; the buffer is partitioned last.
+        //
+        // Several vectors are read at once, which leaves more room
+        // for the processor to overlap the partitioning of different
+        // vectors and amortizes the mispredictions of the branch
+        // choosing the side to read from.
+
+        template<typename Ops, bool Descending, typename T>
+        CPPSORT_TARGET_AVX2
+        auto avx2_partition_vector(typename Ops::vector_type vec,
+                                   typename Ops::vector_type pivot,
+                                   T*& write_left, T*& write_right) noexcept
+            -> void
+        {
+            int mask = Descending ?
+                Ops::greater_mask(vec, pivot) :
+                Ops::greater_mask(pivot, vec);
+            int nb_left = __builtin_popcount(static_cast<unsigned>(mask));
+
+            // The whole partitioned vector is written on both sides,
+            // the elements that don't belong there are overwritten
+            // later
+            vec = Ops::compress(vec, mask);
+            Ops::store(write_left, vec);
+            Ops::store(write_right - Ops::lanes, vec);
+            write_left += nb_left;
+            write_right -= Ops::lanes - nb_left;
+        }
+
+        template<bool Descending, typename T>
+        CPPSORT_TARGET_AVX2
+        auto avx2_partition(T* first, T* last, T pivot) noexcept
+            -> T*
+        {
+            using ops = avx2_ops<T>;
+            constexpr int lanes = ops::lanes;
+            constexpr int block_size = unroll * lanes;
+            if (last - first < 2 * block_size) {
+                return small_partition<Descending>(first, last, pivot);
+            }
+
+            auto pivot_vec = ops::broadcast(pivot);
+            T buffer[2 * block_size];
+            for (int idx = 0 ; idx < block_size ; idx += lanes) {
+                ops::store(buffer + idx, ops::load(first + idx));
+                ops::store(buffer + block_size + idx, ops::load(last - block_size + idx));
+            }
+
+            T* read_left = first + block_size;
+            T* read_right = last - block_size;
+            T* write_left = first;
+            T* write_right = last;
+
+            while (read_right - read_left >= block_size) {
+                T* read;
+                if (read_left - write_left <= write_right - read_right) {
+                    read = read_left;
+                    read_left += block_size;
+                } else {
+                    read_right -= block_size;
+                    read = read_right;
+                }
+
+                // Everything has to be read before anything is written
+                auto vec0 = ops::load(read);
+                auto vec1 = ops::load(read + lanes);
+                auto vec2 = ops::load(read + 2 * lanes);
+                auto vec3 = ops::load(read + 3 * lanes);
+                avx2_partition_vector<ops, Descending>(vec0, pivot_vec, write_left, write_right);
+                avx2_partition_vector<ops, Descending>(vec1, pivot_vec, write_left, write_right);
+                avx2_partition_vector<ops, Descending>(vec2, pivot_vec, write_left, write_right);
+                avx2_partition_vector<ops, Descending>(vec3, pivot_vec, write_left, write_right);
+            }
+
+            while (read_right - read_left >= lanes) {
+                typename ops::vector_type vec;
+                if (read_left - write_left <= write_right - read_right) {
+                    vec = ops::load(read_left);
+                    read_left += lanes;
+                } else {
+                    read_right -= lanes;
+                    vec = ops::load(read_right);
+                }
+                avx2_partition_vector<ops, Descending>(vec, pivot_vec, write_left, write_right);
+            }
+            partition_remaining<Descending>(read_left, read_right, write_left, write_right, pivot);
+
+            for (int idx = 0 ; idx < 2 * block_size ; idx += lanes) {
+                avx2_partition_vector<ops, Descending>(ops::load(buffer + idx), pivot_vec,
+                                                       write_left, write_right);
+            }
+            return write_left;
+        }
+
+        template<typename Ops, bool Descending, typename T>
+        CPPSORT_TARGET_AVX512
+        auto avx512_partition_vector(typename Ops::vector_type vec,
+                                     typename Ops::vector_type pivot,
+                                     T*& write_left, T*& write_right) noexcept
+            -> void
+        {
+            using mask_type = typename Ops::mask_type;
+            mask_type mask = Descending ?
+                Ops::greater_mask(vec, pivot) :
+                Ops::greater_mask(pivot, vec);
+            int nb_left = __builtin_popcount(static_cast<unsigned>(mask));
+            int nb_right = Ops::lanes - nb_left;
+
+            // The full store on the left has to happen first: when
+            // both sides meet, the masked store on the right
+            // overwrites the zeroed lanes it wrote
+            Ops::store(write_left, Ops::compress(vec, mask));
+            Ops::store(write_right - nb_right,
+                       static_cast<mask_type>((1u << nb_right) - 1u),
+                       Ops::compress(vec, static_cast<mask_type>(~mask)));
+            write_left += nb_left;
+            write_right -= nb_right;
+        }
+
+        template<bool Descending, typename T>
+        CPPSORT_TARGET_AVX512
+        auto avx512_partition(T* first, T* last, T pivot) noexcept
+            -> T*
+        {
+            using ops = avx512_ops<T>;
+            constexpr int lanes = ops::lanes;
+            constexpr int block_size = unroll * lanes;
+            if (last - first < 2 * block_size) {
+                return small_partition<Descending>(first, last, pivot);
+            }
+
+            auto pivot_vec = ops::broadcast(pivot);
+            T buffer[2 * block_size];
+            for (int idx = 0 ; idx < block_size ; idx += lanes) {
+                ops::store(buffer + idx, ops::load(first + idx));
+                ops::store(buffer + block_size + idx, ops::load(last - block_size + idx));
+            }
+
+            T* read_left = first + block_size;
+            T* read_right = last - block_size;
+            T* write_left = first;
+            T* write_right = last;
+
+            while (read_right - read_left >= block_size) {
+                T* read;
+                if (read_left - write_left <= write_right - read_right) {
+                    read = read_left;
+                    read_left += block_size;
+                } else {
+                    read_right -= block_size;
+                    read = read_right;
+                }
+
+                // Everything has to be read before anything is written
+                auto vec0 = ops::load(read);
+                auto vec1 = ops::load(read + lanes);
+                auto vec2 = ops::load(read + 2 * lanes);
+                auto vec3 = ops::load(read + 3 * lanes);
+                avx512_partition_vector<ops, Descending>(vec0, pivot_vec, write_left, write_right);
+                avx512_partition_vector<ops, Descending>(vec1, pivot_vec, write_left, write_right);
+                avx512_partition_vector<ops, Descending>(vec2, pivot_vec, write_left, write_right);
+                avx512_partition_vector<ops, Descending>(vec3, pivot_vec, write_left, write_right);
+            }
+
+            while (read_right - read_left >= lanes) {
+                typename ops::vector_type vec;
+                if (read_left - write_left <= write_right - read_right) {
+                    vec = ops::load(read_left);
+                    read_left += lanes;
+                } else {
+                    read_right -= lanes;
+                    vec = ops::load(read_right);
+                }
+                avx512_partition_vector<ops, Descending>(vec, pivot_vec, write_left, write_right);
+            }
+            partition_remaining<Descending>(read_left, read_right, write_left, write_right, pivot);
+
+            for (int idx = 0 ; idx < 2 * block_size ; idx += lanes) {
+                avx512_partition_vector<ops, Descending>(ops::load(buffer + idx), pivot_vec,
+                                                         write_left, write_right);
+            }
+            return write_left;
+        }
+    }
+
+    // Partitions [first, last) so that the elements that compare
+    // less than the pivot come first and returns the partition
+    // point, the order of the elements in each partition is not
+    // preserved; the CPU has to support at least AVX2
+    template<bool Descending, typename T>
+    auto simd_partition(T* first, T* last, T pivot) noexcept
+        -> T*
+    {
+        if (cpu_supports_avx512()) {
+            return simd_partition_detail::avx512_partition<Descending>(first, last, pivot);
+        }
+        return simd_partition_detail::avx2_partition<Descending>(first, last, pivot);
+    }
+#endif
+}}
+
+#endif // CPPSORT_DETAIL_SIMD_PARTITION_H_
@@ -0,0 +1,320 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef CPPSORT_DETAIL_SORT_BATCH_H_
+#define CPPSORT_DETAIL_SORT_BATCH_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <cpp-sort/utility/functional.h>
+#include "iterator_traits.h"
+#include "network_sort.h"
+#include "task_pool.h"
+
+namespace cppsort
+{
+namespace detail
+{
+    ////////////////////////////////////////////////////////////
+    // Several segments sorted at once
+
+    // Element i of every segment is stored in the same pack, so
+    // that a compare-exchange between two packs sorts one pair of
+    // elements in each segment; the loops over the lanes are
+    // simple enough for the compilers to vectorize them
+    template<typename T, std::size_t Width>
+    struct lane_pack
+    {
+        T values[Width];
+    };
+
+    // Enough lanes to fill a cache line
+    template<typename T>
+    constexpr std::size_t lane_pack_width = 64 / sizeof(T) < 4 ? 4 : 64 / sizeof(T);
+
+    // Comparison used to run the sorting networks on lane packs:
+    // the compare-exchange operations are performed by the swap_if
+    // overloads below, which never call it
+    template<typename Compare>
+    struct lanes_compare
+    {
+        template<typename T, std::size_t Width>
+        auto operator()(const lane_pack<T, Width>&, const lane_pack<T, Width>&) const noexcept
+            -> bool
+        {
+            return false;
+        }
+    };
+
+    template<typename T, std::size_t Width>
+    auto swap_if(lane_pack<T, Width>& x, lane_pack<T, Width>& y,
+                 lanes_compare<std::less<>>, utility::identity) noexcept
+        -> void
+    {
+        for (std::size_t lane = 0 ; lane < Width ; ++lane) {
+            T dx = x.values[lane];
+            x.values[lane] = std::min(dx, y.values[lane]);
+            y.values[lane] = std::max(y.values[lane], dx);
+        }
+    }
+
+    template<typename T, std::size_t Width>
+    auto swap_if(lane_pack<T, Width>& x, lane_pack<T, Width>& y,
+                 lanes_compare<std::greater<>>, utility::identity) noexcept
+        -> void
+    {
+        for (std::size_t lane = 0 ; lane < Width ; ++lane) {
+            T dx = x.values[lane];
+            x.values[lane] = std::max(dx, y.values[lane]);
+            y.values[lane] = std::min(y.values[lane], dx);
+        }
+    }
+
+    template<typename T, typename Compare, typename Projection>
+    using can_sort_lanes = std::integral_constant<bool,
+        std::is_arithmetic<T>::value &&
+        std::is_same<Projection, utility::identity>::value && (
+            std::is_same<Compare, std::less<>>::value ||
+            std::is_same<Compare, std::greater<>>::value
+        )
+    >;
+
+    ////////////////////////////////////////////////////////////
+    // Units of work
+
+    struct batch_item
+    {
+        // Range of indices in the segments order
+        std::size_t begin;
+        std::size_t end;
+        // Size of the segments when they are sorted as lanes,
+        // 0 when a single segment is sorted with the sorter
+        std::ptrdiff_t lanes_size;
+    };
+
+    template<typename Sorter, typename RandomAccessIterator, typename OffsetIterator,
+             typename Compare, typename Projection>
+    struct batch_context
+    {
+        using difference_type = difference_type_t<RandomAccessIterator>;
+        using value_type = value_type_t<RandomAccessIterator>;
+
+        const Sorter& sorter;
+        RandomAccessIterator first;
+        OffsetIterator offsets;
+        Compare compare;
+        Projection projection;
+        std::vector<std::size_t> order;
+
+        auto segment_begin(std::size_t segment) const
+            -> RandomAccessIterator
+        {
+            return first + static_cast<difference_type>(offsets[segment]);
+        }
+
+        auto segment_size(std::size_t segment) const
+            -> difference_type
+        {
+            return static_cast<difference_type>(offsets[segment + 1])
+                 - static_cast<difference_type>(offsets[segment]);
+        }
+
+        auto sort_item(const batch_item& item) const
+            -> void
+        {
+            if (item.lanes_size == 0) {
+                auto segment = order[item.begin];
+                auto begin = segment_begin(segment);
+                sorter(begin, begin + segment_size(segment), compare, projection);
+            } else {
+                sort_lanes(item, can_sort_lanes<value_type, Compare, Projection>{});
+            }
+        }
+
+        auto sort_lanes(const batch_item&, std::false_type) const
+            -> void
+        {}
+
+        auto sort_lanes(const batch_item& item, std::true_type) const
+            -> void
+        {
+            constexpr std::size_t width = lane_pack_width<value_type>;
+            lane_pack<value_type, width> packs[network_sort_max_size];
+
+            // Gather the segments in the lanes, the unused lanes
+            // are filled with copies of the first segment
+            auto nb_segments = item.end - item.begin;
+            std::ptrdiff_t size = item.lanes_size;
+            for (std::size_t lane = 0 ; lane < width ; ++lane) {
+                auto segment = order[item.begin + (lane < nb_segments ? lane : 0)];
+                auto it = segment_begin(segment);
+                for (std::ptrdiff_t idx = 0 ; idx < size ; ++idx) {
+                    packs[idx].values[lane] = it[idx];
+                }
+            }
+
+            network_sort(packs + 0, packs + size, lanes_compare<Compare>{}, projection,
+                         std::make_index_sequence<network_sort_max_size + 1>{});
+
+            for (std::size_t lane = 0 ; lane < nb_segments ; ++lane) {
+                auto it = segment_begin(order[item.begin + lane]);
+                for (std::ptrdiff_t idx = 0 ; idx < size ; ++idx) {
+                    it[idx] = packs[idx].values[lane];
+                }
+            }
+        }
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Batched sort
+
+    // Batches smaller than this are never split between threads
+    constexpr std::ptrdiff_t sort_batch_min_chunk_size = 1 << 15;
+
+    // Number of elements in a window of segments bucketed together
+    constexpr std::ptrdiff_t sort_batch_window_size = 1 << 14;
+
+    template<typename Sorter, typename RandomAccessIterator, typename OffsetIterator,
+             typename Compare, typename Projection>
+    auto sort_batch(const Sorter& sorter, RandomAccessIterator first,
+                    OffsetIterator offsets_first, OffsetIterator offsets_last,
+                    Compare compare, Projection projection, std::size_t nb_threads)
+        -> void
+    {
+        using context_type = batch_context<
+            Sorter, RandomAccessIterator, OffsetIterator, Compare, Projection
+        >;
+        using lanes = can_sort_lanes<value_type_t<RandomAccessIterator>, Compare, Projection>;
+
+        auto nb_offsets = std::distance(offsets_first, offsets_last);
+        if (nb_offsets < 2) return;
+        auto nb_segments = static_cast<std::size_t>(nb_offsets - 1);
+
+        context_type context = {
+            sorter, first, offsets_first,
+            std::move(compare), std::move(projection), {}
+        };
+
+        // The segments are processed by windows of consecutive
+        // segments small enough to stay in cache; in every window
+        // the small segments are bucketed by size to be sorted as
+        // lanes, and the bigger ones go last
+        std::ptrdiff_t max_lanes_size = lanes::value ? network_sort_max_size : 1;
+        auto bucket_of = [&](std::size_t segment) {
+            auto size = context.segment_size(segment);
+            return static_cast<std::size_t>(size > max_lanes_size ? max_lanes_size + 1 : size);
+        };
+
+        constexpr std::size_t width = lane_pack_width<value_type_t<RandomAccessIterator>>;
+        std::vector<std::size_t> counts(static_cast<std::size_t>(max_lanes_size) + 2);
+        std::vector<std::size_t> starts(counts.size());
+        std::vector<batch_item> items;
+        std::vector<std::ptrdiff_t> items_sizes;
+        context.order.resize(nb_segments);
+
+        std::size_t window_begin = 0;
+        while (window_begin < nb_segments) {
+            std::size_t window_end = window_begin;
+            std::ptrdiff_t window_size = 0;
+            std::fill(counts.begin(), counts.end(), 0);
+            do {
+                window_size += context.segment_size(window_end);
+                ++counts[bucket_of(window_end)];
+                ++window_end;
+            } while (window_end < nb_segments && window_size < sort_batch_window_size);
+
+            starts[0] = window_begin;
+            for (std::size_t bucket = 1 ; bucket < counts.size() ; ++bucket) {
+                starts[bucket] = starts[bucket - 1] + counts[bucket - 1];
+            }
+            for (std::size_t segment = window_begin ; segment < window_end ; ++segment) {
+                context.order[starts[bucket_of(segment)]++] = segment;
+            }
+
+            // Build the units of work, segments of 0 or 1 element
+            // are already sorted and don't need any
+            std::size_t pos = window_begin + counts[0] + counts[1];
+            for (std::size_t bucket = 2 ; bucket <= static_cast<std::size_t>(max_lanes_size) ; ++bucket) {
+                auto end = pos + counts[bucket];
+                while (pos < end) {
+                    auto item_end = std::min(end, pos + width);
+                    items.push_back({ pos, item_end, static_cast<std::ptrdiff_t>(bucket) });
+                    items_sizes.push_back(static_cast<std::ptrdiff_t>((item_end - pos) * bucket));
+                    pos = item_end;
+                }
+            }
+            for (; pos < window_end ; ++pos) {
+                items.push_back({ pos, pos + 1, 0 });
+                items_sizes.push_back(context.segment_size(context.order[pos]));
+            }
+            window_begin = window_end;
+        }
+
+        // Don't spawn threads that wouldn't have anything to do
+        std::ptrdiff_t total_size = 0;
+        for (auto size: items_sizes) {
+            total_size += size;
+        }
+        nb_threads = parallel_threads_count(
+            nb_threads,
+            static_cast<std::size_t>(total_size / sort_batch_min_chunk_size)
+        );
+        if (nb_threads == 1) {
+            for (const auto& item: items) {
+                context.sort_item(item);
+            }
+            return;
+        }
+
+        // Give every task a contiguous range of items holding
+        // roughly the same number of elements
+        auto& pool = task_pool::shared(nb_threads - 1);
+        task_group group(pool);
+        auto nb_chunks = static_cast<std::ptrdiff_t>(4 * nb_threads);
+        std::size_t chunk_begin = 0;
+        std::ptrdiff_t accumulated = 0;
+        for (std::size_t idx = 0 ; idx < items.size() ; ++idx) {
+            accumulated += items_sizes[idx];
+            if (accumulated * nb_chunks >= total_size || idx + 1 == items.size()) {
+                group.run([&context, &items, chunk_begin, chunk_end=idx+1] {
+                    for (auto item = chunk_begin ; item < chunk_end ; ++item) {
+                        context.sort_item(items[item]);
+                    }
+                });
+                chunk_begin = idx + 1;
+                accumulated = 0;
+            }
+        }
+        group.wait();
+    }
+}}
+
+#endif // CPPSORT_DETAIL_SORT_BATCH_H_
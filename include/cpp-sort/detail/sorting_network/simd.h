@@ -0,0 +1,618 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef CPPSORT_DETAIL_SORTING_NETWORK_SIMD_H_
+#define CPPSORT_DETAIL_SORTING_NETWORK_SIMD_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <cpp-sort/sorter_traits.h>
+#include <cpp-sort/utility/functional.h>
+#include "../iterator_traits.h"
+#include "../simd.h"
+
+namespace cppsort
+{
+namespace detail
+{
+#ifdef CPPSORT_X86_SIMD
+    namespace simd_network_detail
+    {
+        ////////////////////////////////////////////////////////////
+        // Compile-time helpers
+
+        // Mask of the lanes holding the greatest element of each
+        // pair when the elements i and i^X of a vector are compared
+        constexpr auto upper_lanes_mask(int x, int lanes) noexcept
+            -> int
+        {
+            int high_bit = 1;
+            while (high_bit * 2 <= x) {
+                high_bit *= 2;
+            }
+            int mask = 0;
+            for (int i = 0 ; i < lanes ; ++i) {
+                if (i & high_bit) {
+                    mask |= 1 << i;
+                }
+            }
+            return mask;
+        }
+
+        // Shuffle immediate replacing each of four elements i by
+        // the element i^X
+        constexpr auto xor_shuffle_imm(int x) noexcept
+            -> int
+        {
+            return ((0 ^ x) & 3)
+                 | (((1 ^ x) & 3) << 2)
+                 | (((2 ^ x) & 3) << 4)
+                 | (((3 ^ x) & 3) << 6);
+        }
+
+        // Shuffle immediate rotating four elements so that the
+        // element i is replaced by the element (i + Shift) % 4
+        constexpr auto rotate_shuffle_imm(int shift) noexcept
+            -> int
+        {
+            return (shift % 4)
+                 | (((1 + shift) % 4) << 2)
+                 | (((2 + shift) % 4) << 4)
+                 | (((3 + shift) % 4) << 6);
+        }
+
+        // Blend immediate for 32-bit lanes from a blend mask
+        // for 64-bit lanes
+        constexpr auto widen_blend_mask(int mask) noexcept
+            -> int
+        {
+            int res = 0;
+            for (int i = 0 ; i < 4 ; ++i) {
+                if (mask & (1 << i)) {
+                    res |= 3 << (2 * i);
+                }
+            }
+            return res;
+        }
+
+        constexpr auto next_power_of_2(int value) noexcept
+            -> int
+        {
+            int res = 1;
+            while (res < value) {
+                res *= 2;
+            }
+            return res;
+        }
+
+        // Padding value sorted after every other value of the
+        // collection, infinities are needed for floating point
+        // types since they would otherwise end up after the
+        // padding elements
+        template<typename T>
+        constexpr auto padding_value(std::false_type /* descending */) noexcept
+            -> T
+        {
+            return std::numeric_limits<T>::has_infinity ?
+                std::numeric_limits<T>::infinity() :
+                (std::numeric_limits<T>::max)();
+        }
+
+        template<typename T>
+        constexpr auto padding_value(std::true_type /* descending */) noexcept
+            -> T
+        {
+            return std::numeric_limits<T>::has_infinity ?
+                -std::numeric_limits<T>::infinity() :
+                std::numeric_limits<T>::lowest();
+        }
+
+        ////////////////////////////////////////////////////////////
+        // Vector operations for every handled type
+
+        template<typename T, typename=void>
+        struct avx2_ops;
+
+        template<>
+        struct avx2_ops<float>
+        {
+            using vector_type = __m256;
+            static constexpr int lanes = 8;
+
+            CPPSORT_TARGET_AVX2
+            static auto broadcast(float value) noexcept
+                -> __m256
+            {
+                return _mm256_set1_ps(value);
+            }
+
+            CPPSORT_TARGET_AVX2
+            static auto load(const float* ptr) noexcept
+                -> __m256
+            {
+                return _mm256_loadu_ps(ptr);
+            }
+
+            CPPSORT_TARGET_AVX2
+            static auto store(float* ptr, __m256 vec) noexcept
+                -> void
+            {
+                _mm256_storeu_ps(ptr, vec);
+            }
+
+            CPPSORT_TARGET_AVX2
+            static auto min(__m256 lhs, __m256 rhs) noexcept
+                -> __m256
+            {
+                return _mm256_min_ps(lhs, rhs);
+            }
+
+            CPPSORT_TARGET_AVX2
+            static auto max(__m256 lhs, __m256 rhs) noexcept
+                -> __m256
+            {
+                return _mm256_max_ps(lhs, rhs);
+            }
+
+            template<int X>
+            CPPSORT_TARGET_AVX2
+            static auto xor_permute(__m256 vec) noexcept
+                -> __m256
+            {
+                if (X < 4) {
+                    constexpr int imm = xor_shuffle_imm(X);
+                    return _mm256_permute_ps(vec, imm);
+                }
+                if (X == 4) {
+                    return _mm256_permute2f128_ps(vec, vec, 0x01);
+                }
+                return _mm256_permutevar8x32_ps(vec, _mm256_setr_epi32(
+                    0 ^ X, 1 ^ X, 2 ^ X, 3 ^ X, 4 ^ X, 5 ^ X, 6 ^ X, 7 ^ X
+                ));
+            }
+
+            template<int Shift>
+            CPPSORT_TARGET_AVX2
+            static auto rotate(__m256 vec) noexcept
+                -> __m256
+            {
+                return _mm256_permutevar8x32_ps(vec, _mm256_setr_epi32(
+                    Shift % 8, (1 + Shift) % 8, (2 + Shift) % 8, (3 + Shift) % 8,
+                    (4 + Shift) % 8, (5 + Shift) % 8, (6 + Shift) % 8, (7 + Shift) % 8
+                ));
+            }
+
+            template<int Mask>
+            CPPSORT_TARGET_AVX2
+            static auto blend(__m256 lhs, __m256 rhs) noexcept
+                -> __m256
+            {
+                return _mm256_blend_ps(lhs, rhs, Mask);
+            }
+        };
+
+        template<typename T>
+        struct avx2_ops<T, std::enable_if_t<std::is_integral<T>::value && sizeof(T) == 4>>
+        {
+            using vector_type = __m256i;
+            static constexpr int lanes = 8;
+
+            CPPSORT_TARGET_AVX2
+            static auto broadcast(T value) noexcept
+                -> __m256i
+            {
+                return _mm256_set1_epi32(value);
+            }
+
+            CPPSORT_TARGET_AVX2
+            static auto load(const T* ptr) noexcept
+                -> __m256i
+            {
+                return _mm256_loadu_si256(static_cast<const __m256i*>(static_cast<const void*>(ptr)));
+            }
+
+            CPPSORT_TARGET_AVX2
+            static auto store(T* ptr, __m256i vec) noexcept
+                -> void
+            {
+                _mm256_storeu_si256(static_cast<__m256i*>(static_cast<void*>(ptr)), vec);
+            }
+
+            CPPSORT_TARGET_AVX2
+            static auto min(__m256i lhs, __m256i rhs) noexcept
+                -> __m256i
+            {
+                return _mm256_min_epi32(lhs, rhs);
+            }
+
+            CPPSORT_TARGET_AVX2
+            static auto max(__m256i lhs, __m256i rhs) noexcept
+                -> __m256i
+            {
+                return _mm256_max_epi32(lhs, rhs);
+            }
+
+            template<int X>
+            CPPSORT_TARGET_AVX2
+            static auto xor_permute(__m256i vec) noexcept
+                -> __m256i
+            {
+                if (X < 4) {
+                    constexpr int imm = xor_shuffle_imm(X);
+                    return _mm256_shuffle_epi32(vec, imm);
+                }
+                if (X == 4) {
+                    return _mm256_permute2x128_si256(vec, vec, 0x01);
+                }
+                return _mm256_permutevar8x32_epi32(vec, _mm256_setr_epi32(
+                    0 ^ X, 1 ^ X, 2 ^ X, 3 ^ X, 4 ^ X, 5 ^ X, 6 ^ X, 7 ^ X
+                ));
+            }
+
+            template<int Shift>
+            CPPSORT_TARGET_AVX2
+            static auto rotate(__m256i vec) noexcept
+                -> __m256i
+            {
+                return _mm256_permutevar8x32_epi32(vec, _mm256_setr_epi32(
+                    Shift % 8, (1 + Shift) % 8, (2 + Shift) % 8, (3 + Shift) % 8,
+                    (4 + Shift) % 8, (5 + Shift) % 8, (6 + Shift) % 8, (7 + Shift) % 8
+                ));
+            }
+
+            template<int Mask>
+            CPPSORT_TARGET_AVX2
+            static auto blend(__m256i lhs, __m256i rhs) noexcept
+                -> __m256i
+            {
+                return _mm256_blend_epi32(lhs, rhs, Mask);
+            }
+        };
+
+        template<typename T>
+        struct avx2_ops<T, std::enable_if_t<std::is_integral<T>::value && sizeof(T) == 8>>
+        {
+            using vector_type = __m256i;
+            static constexpr int lanes = 4;
+
+            CPPSORT_TARGET_AVX2
+            static auto broadcast(T value) noexcept
+                -> __m256i
+            {
+                return _mm256_set1_epi64x(value);
+            }
+
+            CPPSORT_TARGET_AVX2
+            static auto load(const T* ptr) noexcept
+                -> __m256i
+            {
+                return _mm256_loadu_si256(static_cast<const __m256i*>(static_cast<const void*>(ptr)));
+            }
+
+            CPPSORT_TARGET_AVX2
+            static auto store(T* ptr, __m256i vec) noexcept
+                -> void
+            {
+                _mm256_storeu_si256(static_cast<__m256i*>(static_cast<void*>(ptr)), vec);
+            }
+
+            // There are no 64-bit integer min/max instructions before AVX-512
+
+            CPPSORT_TARGET_AVX2
+            static auto min(__m256i lhs, __m256i rhs) noexcept
+                -> __m256i
+            {
+                return _mm256_blendv_epi8(lhs, rhs, _mm256_cmpgt_epi64(lhs, rhs));
+            }
+
+            CPPSORT_TARGET_AVX2
+            static auto max(__m256i lhs, __m256i rhs) noexcept
+                -> __m256i
+            {
+                return _mm256_blendv_epi8(rhs, lhs, _mm256_cmpgt_epi64(lhs, rhs));
+            }
+
+            template<int X>
+            CPPSORT_TARGET_AVX2
+            static auto xor_permute(__m256i vec) noexcept
+                -> __m256i
+            {
+                if (X == 1) {
+                    return _mm256_shuffle_epi32(vec, 0x4e);
+                }
+                if (X == 2) {
+                    return _mm256_permute2x128_si256(vec, vec, 0x01);
+                }
+                constexpr int imm = xor_shuffle_imm(X);
+                return _mm256_permute4x64_epi64(vec, imm);
+            }
+
+            template<int Shift>
+            CPPSORT_TARGET_AVX2
+            static auto rotate(__m256i vec) noexcept
+                -> __m256i
+            {
+                constexpr int imm = rotate_shuffle_imm(Shift);
+                return _mm256_permute4x64_epi64(vec, imm);
+            }
+
+            template<int Mask>
+            CPPSORT_TARGET_AVX2
+            static auto blend(__m256i lhs, __m256i rhs) noexcept
+                -> __m256i
+            {
+                constexpr int imm = widen_blend_mask(Mask);
+                return _mm256_blend_epi32(lhs, rhs, imm);
+            }
+        };
+
+        ////////////////////////////////////////////////////////////
+        // Sorting the lanes of a single vector
+
+        // Compare-exchange of every element i with the element i^X,
+        // which is a full layer of a bitonic sorting network
+        template<typename Ops, int X, bool Descending>
+        CPPSORT_TARGET_AVX2
+        auto compare_lanes(typename Ops::vector_type vec) noexcept
+            -> typename Ops::vector_type
+        {
+            constexpr int upper_mask = upper_lanes_mask(X, Ops::lanes);
+            constexpr int mask = Descending ? (~upper_mask & ((1 << Ops::lanes) - 1)) : upper_mask;
+
+            // Every lane takes its result from a different operand order
+            // than its partner lane, so for floating point types, whose
+            // min and max return their second operand for ±0 and NaN,
+            // the pair always ends up with both of its elements
+            auto other = Ops::template xor_permute<X>(vec);
+            return Ops::template blend<mask>(Ops::min(vec, other), Ops::max(vec, other));
+        }
+
+        template<typename Ops, bool Descending>
+        CPPSORT_TARGET_AVX2
+        auto sort_lanes(typename Ops::vector_type vec, std::integral_constant<int, 4>) noexcept
+            -> typename Ops::vector_type
+        {
+            vec = compare_lanes<Ops, 1, Descending>(vec);
+            vec = compare_lanes<Ops, 3, Descending>(vec);
+            return compare_lanes<Ops, 1, Descending>(vec);
+        }
+
+        template<typename Ops, bool Descending>
+        CPPSORT_TARGET_AVX2
+        auto sort_lanes(typename Ops::vector_type vec, std::integral_constant<int, 8>) noexcept
+            -> typename Ops::vector_type
+        {
+            // Sort both halves first
+            vec = sort_lanes<Ops, Descending>(vec, std::integral_constant<int, 4>{});
+            vec = compare_lanes<Ops, 7, Descending>(vec);
+            vec = compare_lanes<Ops, 2, Descending>(vec);
+            return compare_lanes<Ops, 1, Descending>(vec);
+        }
+
+        // Sorts a bitonic sequence stored in the lanes of a vector
+
+        template<typename Ops, bool Descending>
+        CPPSORT_TARGET_AVX2
+        auto merge_lanes(typename Ops::vector_type vec, std::integral_constant<int, 4>) noexcept
+            -> typename Ops::vector_type
+        {
+            vec = compare_lanes<Ops, 2, Descending>(vec);
+            return compare_lanes<Ops, 1, Descending>(vec);
+        }
+
+        template<typename Ops, bool Descending>
+        CPPSORT_TARGET_AVX2
+        auto merge_lanes(typename Ops::vector_type vec, std::integral_constant<int, 8>) noexcept
+            -> typename Ops::vector_type
+        {
+            vec = compare_lanes<Ops, 4, Descending>(vec);
+            return merge_lanes<Ops, Descending>(vec, std::integral_constant<int, 4>{});
+        }
+
+        ////////////////////////////////////////////////////////////
+        // Sorting network for N elements
+
+        // The elements are loaded in as few vectors as possible,
+        // padded to a power of 2 elements with values that are
+        // guaranteed to be sorted last, then sorted with a bitonic
+        // sorting network whose compare-exchange units operate on
+        // whole vectors; N has to be at least the number of lanes
+        template<std::size_t N, typename T, bool Descending>
+        CPPSORT_TARGET_AVX2
+        auto sort_n(T* data) noexcept
+            -> void
+        {
+            using ops = avx2_ops<T>;
+            using vector_type = typename ops::vector_type;
+            using lanes_t = std::integral_constant<int, ops::lanes>;
+
+            constexpr int size = static_cast<int>(N);
+            constexpr int lanes = ops::lanes;
+            constexpr int nb_full = size / lanes;
+            constexpr int remainder = size % lanes;
+            constexpr int nb_vectors = next_power_of_2((size + lanes - 1) / lanes);
+            static_assert(nb_full > 0, "there should be at least a full vector of elements to sort");
+
+            auto fill = ops::broadcast(
+                padding_value<T>(std::integral_constant<bool, Descending>{})
+            );
+
+            vector_type vec[nb_vectors];
+            for (int i = 0 ; i < nb_full ; ++i) {
+                vec[i] = ops::load(data + i * lanes);
+            }
+            for (int i = nb_full ; i < nb_vectors ; ++i) {
+                vec[i] = fill;
+            }
+            if (remainder != 0) {
+                // Load the last elements with an overlapping load, then
+                // replace the ones that were already loaded, the order
+                // of the elements within a vector doesn't matter here
+                constexpr int mask = ((1 << lanes) - 1) & ~((1 << (lanes - remainder)) - 1);
+                vec[nb_full] = ops::template blend<mask>(fill, ops::load(data + size - lanes));
+            }
+
+            for (int i = 0 ; i < nb_vectors ; ++i) {
+                vec[i] = sort_lanes<ops, Descending>(vec[i], lanes_t{});
+            }
+
+            for (int block_size = 2 ; block_size <= nb_vectors ; block_size *= 2) {
+                // Compare the element i of each block with the element
+                // block_size-i-1, which makes both halves of the blocks
+                // bitonic sequences
+                for (int block = 0 ; block < nb_vectors ; block += block_size) {
+                    for (int i = 0 ; i < block_size / 2 ; ++i) {
+                        auto& lhs = vec[block + i];
+                        auto& rhs = vec[block + block_size - i - 1];
+                        auto reversed = ops::template xor_permute<lanes - 1>(rhs);
+                        // The floating point min and max return their second
+                        // operand for ±0 and NaN, passing the operands in a
+                        // different order ensures that no element is lost
+                        auto low = ops::min(lhs, reversed);
+                        auto high = ops::max(reversed, lhs);
+                        lhs = Descending ? high : low;
+                        rhs = ops::template xor_permute<lanes - 1>(Descending ? low : high);
+                    }
+                }
+
+                // Merge the bitonic sequences, vectors first, then lanes
+                for (int stride = block_size / 4 ; stride > 0 ; stride /= 2) {
+                    for (int i = 0 ; i < nb_vectors ; ++i) {
+                        if ((i & stride) == 0) {
+                            auto low = ops::min(vec[i], vec[i + stride]);
+                            auto high = ops::max(vec[i + stride], vec[i]);
+                            vec[i] = Descending ? high : low;
+                            vec[i + stride] = Descending ? low : high;
+                        }
+                    }
+                }
+                for (int i = 0 ; i < nb_vectors ; ++i) {
+                    vec[i] = merge_lanes<ops, Descending>(vec[i], lanes_t{});
+                }
+            }
+
+            if (remainder != 0) {
+                // Overlapping store of the last elements, which are moved
+                // to the upper lanes first, the full vectors stored after
+                // overwrite the elements that don't belong there
+                ops::store(data + size - lanes, ops::template rotate<remainder>(vec[nb_full]));
+            }
+            for (int i = 0 ; i < nb_full ; ++i) {
+                ops::store(data + i * lanes, vec[i]);
+            }
+        }
+    }
+#endif
+
+    ////////////////////////////////////////////////////////////
+    // Sizes for which the vectorized networks are used
+
+    // The vectorized networks need at least a full vector of
+    // elements; when padding is needed they perform more work than
+    // the scalar networks, which compile to efficient branchless
+    // code for floating point types, so they are only used for
+    // those when they are beneficial: never for double, which only
+    // fits 4 elements per vector
+
+    template<std::size_t N, typename T>
+    struct is_vectorized_network_size:
+        std::integral_constant<bool,
+            std::is_integral<T>::value ?
+                (N * sizeof(T) >= 32 && N <= 32) :
+                (std::is_same<T, float>::value && (N == 8 || N == 16 || N == 32))
+        >
+    {};
+
+    ////////////////////////////////////////////////////////////
+    // Sorting network sorter dispatching to vectorized networks
+
+    // Arrays of 32-bit or 64-bit signed integers or of float sorted
+    // with the default comparisons are sorted in vector registers
+    // when the CPU supports AVX2, the scalar sorting networks are
+    // used in every other case
+
+    template<std::size_t N>
+    struct simd_sorting_network_sorter_impl:
+        sorting_network_sorter_impl<N>
+    {
+        template<
+            typename RandomAccessIterator,
+            typename Compare = std::less<>,
+            typename Projection = utility::identity,
+            typename = std::enable_if_t<is_projection_iterator_v<
+                Projection, RandomAccessIterator, Compare
+            >>
+        >
+        auto operator()(RandomAccessIterator first, RandomAccessIterator last,
+                        Compare compare={}, Projection projection={}) const
+            -> void
+        {
+            using can_vectorize = std::integral_constant<bool,
+                is_simd_sortable<RandomAccessIterator, Compare, Projection>::value &&
+                is_vectorized_network_size<N, value_type_t<RandomAccessIterator>>::value
+            >;
+            sort(can_vectorize{}, std::move(first), std::move(last),
+                 std::move(compare), std::move(projection));
+        }
+
+        private:
+
+            template<typename RandomAccessIterator, typename Compare, typename Projection>
+            auto sort(std::false_type, RandomAccessIterator first, RandomAccessIterator last,
+                      Compare compare, Projection projection) const
+                -> void
+            {
+                sorting_network_sorter_impl<N>::operator()(
+                    std::move(first), std::move(last),
+                    std::move(compare), std::move(projection)
+                );
+            }
+
+#ifdef CPPSORT_X86_SIMD
+            template<typename RandomAccessIterator, typename Compare, typename Projection>
+            auto sort(std::true_type, RandomAccessIterator first, RandomAccessIterator last,
+                      Compare compare, Projection projection) const
+                -> void
+            {
+                if (not cpu_supports_avx2()) {
+                    sort(std::false_type{}, std::move(first), std::move(last),
+                         std::move(compare), std::move(projection));
+                    return;
+                }
+
+                using value_type = value_type_t<RandomAccessIterator>;
+                constexpr bool descending = std::is_same<Compare, std::greater<>>::value;
+                simd_network_detail::sort_n<N, value_type, descending>(std::addressof(*first));
+            }
+#endif
+    };
+}}
+
+#endif // CPPSORT_DETAIL_SORTING_NETWORK_SIMD_H_
@@ -375,9 +375,8 @@ namespace detail
                     nptr = (nelem + 1) >> 1;
                     std::size_t nelem_1 = nptr;
                     std::size_t nelem_2 = nelem - nelem_1;
-                    ptr.reset(static_cast<rvalue_reference*>(
-                        ::operator new(nptr * sizeof(rvalue_reference))
-                    ));
+                    ptr.get_deleter() = operator_deleter(nptr * sizeof(rvalue_reference));
+                    ptr.reset(allocate_buffer<rvalue_reference>(nptr));
                     range_buf range_aux(ptr.get(), (ptr.get() + nptr));
 
                     destruct_n<rvalue_reference> d(0);
@@ -0,0 +1,429 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef CPPSORT_DETAIL_TASK_POOL_H_
+#define CPPSORT_DETAIL_TASK_POOL_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace cppsort
+{
+namespace detail
+{
+    //
+    // Small work-stealing thread pool used by the parallel
+    // algorithms of the library
+    //
+    // Every worker thread owns a queue of tasks: it pushes and
+    // pops tasks at the back of its own queue, and steals tasks
+    // at the front of the other queues when its own queue is
+    // empty. An additional queue is used by the threads that
+    // don't belong to the pool: those threads are expected to
+    // participate in the work while waiting for a task_group,
+    // which makes nested fork-join parallelism deadlock-free
+    //
+    // Pools are meant to be reused: the parallel algorithms get
+    // them through task_pool::shared() so that sorting several
+    // collections doesn't spawn and join threads every time
+    //
+
+    class task_pool
+    {
+        public:
+
+            ////////////////////////////////////////////////////////////
+            // Member types
+
+            using task_type = std::function<void()>;
+
+            ////////////////////////////////////////////////////////////
+            // Construction & destruction
+
+            explicit task_pool(std::size_t nb_workers):
+                queues(nb_workers + 1),
+                nb_pending(0),
+                done(false)
+            {
+                for (auto& queue: queues) {
+                    queue = std::make_unique<task_queue>();
+                }
+
+                threads.reserve(nb_workers);
+                try {
+                    for (std::size_t idx = 0 ; idx < nb_workers ; ++idx) {
+                        threads.emplace_back([this, idx] { worker_loop(idx); });
+                    }
+                } catch (...) {
+                    stop();
+                    throw;
+                }
+            }
+
+            task_pool(const task_pool&) = delete;
+            task_pool& operator=(const task_pool&) = delete;
+
+            ~task_pool()
+            {
+                stop();
+            }
+
+            // Returns a pool with the given number of workers, creating
+            // it the first time it is requested; pools live until the
+            // end of the program and can be used by several threads
+            static auto shared(std::size_t nb_workers)
+                -> task_pool&
+            {
+                static std::mutex pools_mutex;
+                static std::map<std::size_t, std::unique_ptr<task_pool>> pools;
+
+                std::lock_guard<std::mutex> lock(pools_mutex);
+                auto& pool = pools[nb_workers];
+                if (not pool) {
+                    pool = std::make_unique<task_pool>(nb_workers);
+                }
+                return *pool;
+            }
+
+            ////////////////////////////////////////////////////////////
+            // Pool information
+
+            // Number of threads able to execute tasks, including
+            // the external thread waiting on the results
+            auto concurrency() const noexcept
+                -> std::size_t
+            {
+                return threads.size() + 1;
+            }
+
+            ////////////////////////////////////////////////////////////
+            // Tasks handling
+
+            auto submit(task_type task)
+                -> void
+            {
+                auto& queue = *queues[current_queue_index()];
+                {
+                    std::lock_guard<std::mutex> lock(queue.mutex);
+                    queue.tasks.push_back(std::move(task));
+                }
+                ++nb_pending;
+
+                // Taking the lock ensures that a worker can't miss
+                // the notification between the moment it checks for
+                // pending tasks and the moment it starts waiting
+                { std::lock_guard<std::mutex> lock(sleep_mutex); }
+                sleep_cv.notify_one();
+            }
+
+            // Runs one of the pending tasks if there is any, returns
+            // whether a task was executed
+            auto run_pending_task()
+                -> bool
+            {
+                task_type task;
+                if (not try_pop(current_queue_index(), task)) {
+                    return false;
+                }
+                task();
+                return true;
+            }
+
+            // Blocks the current thread until there is a pending task
+            // or until the given predicate is satisfied; the predicate
+            // has to be made true by a thread calling notify_waiters()
+            template<typename Predicate>
+            auto wait_for_work(Predicate pred)
+                -> void
+            {
+                std::unique_lock<std::mutex> lock(sleep_mutex);
+                sleep_cv.wait(lock, [&] {
+                    return nb_pending > 0 || pred();
+                });
+            }
+
+            auto notify_waiters()
+                -> void
+            {
+                { std::lock_guard<std::mutex> lock(sleep_mutex); }
+                sleep_cv.notify_all();
+            }
+
+        private:
+
+            struct task_queue
+            {
+                std::mutex mutex;
+                std::deque<task_type> tasks;
+            };
+
+            ////////////////////////////////////////////////////////////
+            // Per-thread information
+
+            auto current_queue_index() const noexcept
+                -> std::size_t
+            {
+                // Threads that don't belong to the pool share the last queue
+                if (current_pool() == this) {
+                    return current_worker();
+                }
+                return threads.size();
+            }
+
+            static auto current_pool() noexcept
+                -> const task_pool*&
+            {
+                thread_local const task_pool* pool = nullptr;
+                return pool;
+            }
+
+            static auto current_worker() noexcept
+                -> std::size_t&
+            {
+                thread_local std::size_t index = 0;
+                return index;
+            }
+
+            ////////////////////////////////////////////////////////////
+            // Queues manipulation
+
+            auto try_pop(std::size_t index, task_type& task)
+                -> bool
+            {
+                // Try to take the most recent task from its own queue
+                {
+                    auto& queue = *queues[index];
+                    std::lock_guard<std::mutex> lock(queue.mutex);
+                    if (not queue.tasks.empty()) {
+                        task = std::move(queue.tasks.back());
+                        queue.tasks.pop_back();
+                        --nb_pending;
+                        return true;
+                    }
+                }
+
+                // Steal the oldest task from another queue, which
+                // generally corresponds to the biggest chunk of work
+                for (std::size_t offset = 1 ; offset < queues.size() ; ++offset) {
+                    auto& queue = *queues[(index + offset) % queues.size()];
+                    std::lock_guard<std::mutex> lock(queue.mutex);
+                    if (not queue.tasks.empty()) {
+                        task = std::move(queue.tasks.front());
+                        queue.tasks.pop_front();
+                        --nb_pending;
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            auto worker_loop(std::size_t index)
+                -> void
+            {
+                current_pool() = this;
+                current_worker() = index;
+
+                task_type task;
+                while (true) {
+                    if (try_pop(index, task)) {
+                        task();
+                        task = nullptr;
+                        continue;
+                    }
+
+                    std::unique_lock<std::mutex> lock(sleep_mutex);
+                    sleep_cv.wait(lock, [this] {
+                        return done || nb_pending > 0;
+                    });
+                    if (done && nb_pending == 0) {
+                        return;
+                    }
+                }
+            }
+
+            auto stop() noexcept
+                -> void
+            {
+                {
+                    std::lock_guard<std::mutex> lock(sleep_mutex);
+                    done = true;
+                }
+                sleep_cv.notify_all();
+                for (auto& thread: threads) {
+                    thread.join();
+                }
+                threads.clear();
+            }
+
+            ////////////////////////////////////////////////////////////
+            // Data members
+
+            std::vector<std::unique_ptr<task_queue>> queues;
+            std::vector<std::thread> threads;
+            std::atomic<std::size_t> nb_pending;
+            bool done;
+            std::mutex sleep_mutex;
+            std::condition_variable sleep_cv;
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Group of tasks that can be waited for
+
+    class task_group
+    {
+        public:
+
+            ////////////////////////////////////////////////////////////
+            // Construction & destruction
+
+            explicit task_group(task_pool& pool) noexcept:
+                pool(pool),
+                nb_running(0)
+            {}
+
+            task_group(const task_group&) = delete;
+            task_group& operator=(const task_group&) = delete;
+
+            ~task_group()
+            {
+                // Never let tasks outlive the group they reference,
+                // exceptions are lost at this point
+                help_until_done();
+            }
+
+            ////////////////////////////////////////////////////////////
+            // Tasks handling
+
+            // Schedules a task to be run by any thread of the pool,
+            // tasks are allowed to schedule more tasks in the group
+            template<typename Function>
+            auto run(Function&& function)
+                -> void
+            {
+                ++nb_running;
+                try {
+                    pool.submit([this, func=std::forward<Function>(function)]() mutable {
+                        try {
+                            func();
+                        } catch (...) {
+                            std::lock_guard<std::mutex> lock(exception_mutex);
+                            if (not exception) {
+                                exception = std::current_exception();
+                            }
+                        }
+                        // The group might be destroyed as soon as the
+                        // counter reaches zero, don't touch it afterwards
+                        auto& task_pool = pool;
+                        if (--nb_running == 0) {
+                            task_pool.notify_waiters();
+                        }
+                    });
+                } catch (...) {
+                    --nb_running;
+                    throw;
+                }
+            }
+
+            // Waits for all the tasks of the group to complete, the
+            // current thread executes pending tasks in the meantime;
+            // the first exception thrown by a task, if any, is then
+            // propagated to the caller
+            auto wait()
+                -> void
+            {
+                help_until_done();
+                if (exception) {
+                    std::rethrow_exception(std::exchange(exception, nullptr));
+                }
+            }
+
+            // Whether one of the tasks exited via an exception, can
+            // be used to cancel the remaining work early
+            auto has_failed()
+                -> bool
+            {
+                std::lock_guard<std::mutex> lock(exception_mutex);
+                return exception != nullptr;
+            }
+
+        private:
+
+            auto help_until_done() noexcept
+                -> void
+            {
+                while (nb_running > 0) {
+                    bool ran_task = false;
+                    try {
+                        ran_task = pool.run_pending_task();
+                    } catch (...) {
+                        // Tasks scheduled through run() never throw,
+                        // std::function's move shouldn't either
+                    }
+                    if (not ran_task) {
+                        // Sleep until there is something to steal or
+                        // until the last task of the group completes
+                        pool.wait_for_work([this] { return nb_running == 0; });
+                    }
+                }
+            }
+
+            task_pool& pool;
+            std::atomic<std::size_t> nb_running;
+            std::mutex exception_mutex;
+            std::exception_ptr exception;
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Helper functions
+
+    // Number of threads to use for a parallel algorithm when the
+    // user explicitly asks for nb_threads (0 meaning "as many as
+    // the hardware supports"), but where creating more than one
+    // thread per chunk of work would be a waste of resources
+    inline auto parallel_threads_count(std::size_t nb_threads, std::size_t nb_chunks) noexcept
+        -> std::size_t
+    {
+        if (nb_threads == 0) {
+            nb_threads = std::thread::hardware_concurrency();
+        }
+        if (nb_threads > nb_chunks) {
+            nb_threads = nb_chunks;
+        }
+        return nb_threads == 0 ? 1 : nb_threads;
+    }
+}}
+
+#endif // CPPSORT_DETAIL_TASK_POOL_H_
@@ -33,6 +33,7 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <algorithm>
+#include <cstddef>
 #include <iterator>
 #include <memory>
 #include <new>
@@ -69,6 +70,49 @@ namespace detail
         {}
     };
 
+    // Merge policy: index of the first of the two pending runs to
+    // merge next so that the lengths of the runs keep decreasing
+    // fast enough from the bottom to the top of the stack, -1 when
+    // the invariants already hold
+    template<typename Runs>
+    auto timsort_collapse_index(const Runs& pending)
+        -> std::ptrdiff_t
+    {
+        if (pending.size() < 2) {
+            return -1;
+        }
+
+        auto n = static_cast<std::ptrdiff_t>(pending.size()) - 2;
+        if ((n > 0 && pending[n - 1].len <= pending[n].len + pending[n + 1].len)
+            || (n > 1 && pending[n - 2].len <= pending[n - 1].len + pending[n].len)) {
+            if (pending[n - 1].len < pending[n + 1].len) {
+                --n;
+            }
+            return n;
+        }
+        if (pending[n].len <= pending[n + 1].len) {
+            return n;
+        }
+        return -1;
+    }
+
+    // Same as above once there are no more runs to push, in which
+    // case all the pending runs have to be merged
+    template<typename Runs>
+    auto timsort_force_collapse_index(const Runs& pending)
+        -> std::ptrdiff_t
+    {
+        if (pending.size() < 2) {
+            return -1;
+        }
+
+        auto n = static_cast<std::ptrdiff_t>(pending.size()) - 2;
+        if (n > 0 && pending[n - 1].len < pending[n + 1].len) {
+            --n;
+        }
+        return n;
+    }
+
     template<typename RandomAccessIterator, typename Compare, typename Projection>
     class TimSort
     {
@@ -205,34 +249,17 @@ namespace detail
         auto mergeCollapse(Compare compare, Projection projection)
             -> void
         {
-            while (pending_.size() > 1) {
-                difference_type n = pending_.size() - 2;
-
-                if ((n > 0 && pending_[n - 1].len <= pending_[n].len + pending_[n + 1].len)
-                    || (n > 1 && pending_[n - 2].len <= pending_[n - 1].len + pending_[n].len)){
-                    if (pending_[n - 1].len < pending_[n + 1].len) {
-                        --n;
-                    }
-                    mergeAt(n, compare, projection);
-                }
-                else if (pending_[n].len <= pending_[n + 1].len) {
-                    mergeAt(n, compare, projection);
-                }
-                else {
-                    break;
-                }
+            std::ptrdiff_t n;
+            while ((n = timsort_collapse_index(pending_)) >= 0) {
+                mergeAt(n, compare, projection);
             }
         }
 
         auto mergeForceCollapse(Compare compare, Projection projection)
             -> void
         {
-            while (pending_.size() > 1) {
-                difference_type n = pending_.size() - 2;
-
-                if (n > 0 && pending_[n - 1].len < pending_[n + 1].len) {
-                    --n;
-                }
+            std::ptrdiff_t n;
+            while ((n = timsort_force_collapse_index(pending_)) >= 0) {
                 mergeAt(n, compare, projection);
             }
         }
@@ -412,9 +439,7 @@ namespace detail
                 // deallocation work properly
                 buffer.reset(nullptr);
                 buffer.get_deleter() = operator_deleter(new_size * sizeof(rvalue_reference));
-                buffer.reset(static_cast<rvalue_reference*>(
-                    ::operator new(new_size * sizeof(rvalue_reference))
-                ));
+                buffer.reset(allocate_buffer<rvalue_reference>(new_size));
                 buffer_size = new_size;
             }
         }
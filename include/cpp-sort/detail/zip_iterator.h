@@ -0,0 +1,405 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef CPPSORT_DETAIL_ZIP_ITERATOR_H_
+#define CPPSORT_DETAIL_ZIP_ITERATOR_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <cpp-sort/utility/iter_move.h>
+#include "iterator_traits.h"
+#include "type_traits.h"
+
+namespace cppsort
+{
+namespace detail
+{
+    //
+    // This header contains utility classes used to sort several
+    // parallel sequences at once (structure of arrays), every
+    // operation on a zip_iterator being applied to all of the
+    // underlying iterators at once
+    //
+    // Dereferencing a zip_iterator returns a zip_reference proxy
+    // which holds references to the elements of every sequence,
+    // and iter_move returns a zip_value which holds the elements
+    // themselves; just like association, a zip_reference can only
+    // be move-assigned
+    //
+    // zip_get<N> is the projection to use to sort the sequences
+    // according to the values of the Nth one
+    //
+
+    template<typename... Values>
+    struct zip_value;
+
+    template<typename... References>
+    struct zip_reference;
+
+    template<typename... Values>
+    struct zip_value
+    {
+        // Public members
+        std::tuple<Values...> values;
+
+        // Can't copy it
+        zip_value(const zip_value&) = delete;
+        zip_value& operator=(const zip_value&) = delete;
+
+        zip_value(zip_value&&) = default;
+        zip_value& operator=(zip_value&&) = default;
+
+        template<typename... Args>
+        explicit zip_value(Args&&... args):
+            values(std::forward<Args>(args)...)
+        {}
+
+        // Silence GCC -Winline warning
+        ~zip_value() noexcept {}
+    };
+
+    template<typename... References>
+    struct zip_reference
+    {
+        // Public members
+        std::tuple<References...> refs;
+
+        explicit zip_reference(References... refs):
+            refs(std::forward<References>(refs)...)
+        {}
+
+        zip_reference(const zip_reference&) = default;
+
+        auto operator=(zip_reference&& other)
+            -> zip_reference&
+        {
+            move_from(other.refs, std::index_sequence_for<References...>{});
+            return *this;
+        }
+
+        auto operator=(zip_value<remove_cvref_t<References>...>&& other)
+            -> zip_reference&
+        {
+            move_from(other.values, std::index_sequence_for<References...>{});
+            return *this;
+        }
+
+        friend auto swap(zip_reference lhs, zip_reference rhs)
+            -> void
+        {
+            lhs.swap_with(rhs, std::index_sequence_for<References...>{});
+        }
+
+        private:
+
+            template<typename Tuple, std::size_t... Indices>
+            auto move_from(Tuple& other, std::index_sequence<Indices...>)
+                -> void
+            {
+                (void) std::initializer_list<int>{
+                    (std::get<Indices>(refs) = std::move(std::get<Indices>(other)), 0)...
+                };
+            }
+
+            template<std::size_t... Indices>
+            auto swap_with(zip_reference& other, std::index_sequence<Indices...>)
+                -> void
+            {
+                using std::swap;
+                (void) std::initializer_list<int>{
+                    (swap(std::get<Indices>(refs), std::get<Indices>(other.refs)), 0)...
+                };
+            }
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Projection to sort on the Nth sequence
+
+    template<std::size_t N>
+    struct zip_get
+    {
+        template<typename... References>
+        constexpr auto operator()(const zip_reference<References...>& ref) const noexcept
+            -> decltype(std::get<N>(ref.refs))
+        {
+            return std::get<N>(ref.refs);
+        }
+
+        template<typename... Values>
+        constexpr auto operator()(zip_value<Values...>& value) const noexcept
+            -> decltype(std::get<N>(value.values))
+        {
+            return std::get<N>(value.values);
+        }
+
+        template<typename... Values>
+        constexpr auto operator()(const zip_value<Values...>& value) const noexcept
+            -> decltype(std::get<N>(value.values))
+        {
+            return std::get<N>(value.values);
+        }
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Iterator over several sequences at once
+
+    template<typename... Iterators>
+    class zip_iterator
+    {
+        public:
+
+            ////////////////////////////////////////////////////////////
+            // Public types
+
+            using iterator_category = std::common_type_t<iterator_category_t<Iterators>...>;
+            using iterator_type     = std::tuple<Iterators...>;
+            using value_type        = zip_value<value_type_t<Iterators>...>;
+            using difference_type   = std::ptrdiff_t;
+            using pointer           = void;
+            using reference         = zip_reference<reference_t<Iterators>...>;
+
+            ////////////////////////////////////////////////////////////
+            // Constructors
+
+            zip_iterator() = default;
+
+            explicit zip_iterator(Iterators... its):
+                _its(std::move(its)...)
+            {}
+
+            ////////////////////////////////////////////////////////////
+            // Members access
+
+            auto base() const
+                -> const iterator_type&
+            {
+                return _its;
+            }
+
+            ////////////////////////////////////////////////////////////
+            // Element access
+
+            auto operator*() const
+                -> reference
+            {
+                return dereference(std::index_sequence_for<Iterators...>{});
+            }
+
+            ////////////////////////////////////////////////////////////
+            // Increment/decrement operators
+
+            auto operator++()
+                -> zip_iterator&
+            {
+                advance(1, std::index_sequence_for<Iterators...>{});
+                return *this;
+            }
+
+            auto operator++(int)
+                -> zip_iterator
+            {
+                auto tmp = *this;
+                operator++();
+                return tmp;
+            }
+
+            auto operator--()
+                -> zip_iterator&
+            {
+                advance(-1, std::index_sequence_for<Iterators...>{});
+                return *this;
+            }
+
+            auto operator--(int)
+                -> zip_iterator
+            {
+                auto tmp = *this;
+                operator--();
+                return tmp;
+            }
+
+            auto operator+=(difference_type increment)
+                -> zip_iterator&
+            {
+                advance(increment, std::index_sequence_for<Iterators...>{});
+                return *this;
+            }
+
+            auto operator-=(difference_type increment)
+                -> zip_iterator&
+            {
+                advance(-increment, std::index_sequence_for<Iterators...>{});
+                return *this;
+            }
+
+            ////////////////////////////////////////////////////////////
+            // Elements access operators
+
+            auto operator[](difference_type pos) const
+                -> reference
+            {
+                return *(*this + pos);
+            }
+
+            ////////////////////////////////////////////////////////////
+            // Comparison operators
+
+            friend auto operator==(const zip_iterator& lhs, const zip_iterator& rhs)
+                -> bool
+            {
+                return std::get<0>(lhs._its) == std::get<0>(rhs._its);
+            }
+
+            friend auto operator!=(const zip_iterator& lhs, const zip_iterator& rhs)
+                -> bool
+            {
+                return std::get<0>(lhs._its) != std::get<0>(rhs._its);
+            }
+
+            ////////////////////////////////////////////////////////////
+            // Relational operators
+
+            friend auto operator<(const zip_iterator& lhs, const zip_iterator& rhs)
+                -> bool
+            {
+                return std::get<0>(lhs._its) < std::get<0>(rhs._its);
+            }
+
+            friend auto operator<=(const zip_iterator& lhs, const zip_iterator& rhs)
+                -> bool
+            {
+                return std::get<0>(lhs._its) <= std::get<0>(rhs._its);
+            }
+
+            friend auto operator>(const zip_iterator& lhs, const zip_iterator& rhs)
+                -> bool
+            {
+                return std::get<0>(lhs._its) > std::get<0>(rhs._its);
+            }
+
+            friend auto operator>=(const zip_iterator& lhs, const zip_iterator& rhs)
+                -> bool
+            {
+                return std::get<0>(lhs._its) >= std::get<0>(rhs._its);
+            }
+
+            ////////////////////////////////////////////////////////////
+            // Arithmetic operators
+
+            friend auto operator+(zip_iterator it, difference_type size)
+                -> zip_iterator
+            {
+                return it += size;
+            }
+
+            friend auto operator+(difference_type size, zip_iterator it)
+                -> zip_iterator
+            {
+                return it += size;
+            }
+
+            friend auto operator-(zip_iterator it, difference_type size)
+                -> zip_iterator
+            {
+                return it -= size;
+            }
+
+            friend auto operator-(const zip_iterator& lhs, const zip_iterator& rhs)
+                -> difference_type
+            {
+                return std::get<0>(lhs._its) - std::get<0>(rhs._its);
+            }
+
+            ////////////////////////////////////////////////////////////
+            // iter_move and iter_swap
+
+            friend auto iter_move(const zip_iterator& it)
+                -> value_type
+            {
+                return it.move_out(std::index_sequence_for<Iterators...>{});
+            }
+
+            friend auto iter_swap(const zip_iterator& lhs, const zip_iterator& rhs)
+                -> void
+            {
+                lhs.swap_with(rhs, std::index_sequence_for<Iterators...>{});
+            }
+
+        private:
+
+            template<std::size_t... Indices>
+            auto dereference(std::index_sequence<Indices...>) const
+                -> reference
+            {
+                return reference(*std::get<Indices>(_its)...);
+            }
+
+            template<std::size_t... Indices>
+            auto advance(difference_type increment, std::index_sequence<Indices...>)
+                -> void
+            {
+                (void) std::initializer_list<int>{
+                    (std::advance(std::get<Indices>(_its), increment), 0)...
+                };
+            }
+
+            template<std::size_t... Indices>
+            auto move_out(std::index_sequence<Indices...>) const
+                -> value_type
+            {
+                using utility::iter_move;
+                return value_type(iter_move(std::get<Indices>(_its))...);
+            }
+
+            template<std::size_t... Indices>
+            auto swap_with(const zip_iterator& other, std::index_sequence<Indices...>) const
+                -> void
+            {
+                using utility::iter_swap;
+                (void) std::initializer_list<int>{
+                    (iter_swap(std::get<Indices>(_its), std::get<Indices>(other._its)), 0)...
+                };
+            }
+
+            std::tuple<Iterators...> _its;
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Construction function
+
+    template<typename... Iterators>
+    auto make_zip_iterator(Iterators... its)
+        -> zip_iterator<Iterators...>
+    {
+        return zip_iterator<Iterators...>(std::move(its)...);
+    }
+}}
+
+#endif // CPPSORT_DETAIL_ZIP_ITERATOR_H_
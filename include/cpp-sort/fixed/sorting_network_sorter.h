@@ -49,11 +49,14 @@ namespace cppsort
                 "sorting_network_sorter has no specialization for this size of N"
             );
         };
+
+        template<std::size_t N>
+        struct simd_sorting_network_sorter_impl;
     }
 
     template<std::size_t N>
     struct sorting_network_sorter:
-        sorter_facade<detail::sorting_network_sorter_impl<N>>
+        sorter_facade<detail::simd_sorting_network_sorter_impl<N>>
     {};
 
     ////////////////////////////////////////////////////////////
@@ -80,6 +83,9 @@ namespace cppsort
     };
 }
 
+// Vectorized sorting networks for some arithmetic types
+#include "../detail/sorting_network/simd.h"
+
 // Specializations of sorting_network_sorter for some values of N
 #include "../detail/sorting_network/sort0.h"
 #include "../detail/sorting_network/sort1.h"
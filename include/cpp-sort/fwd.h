@@ -43,19 +43,31 @@ namespace cppsort
     ////////////////////////////////////////////////////////////
     // Sorters
 
+    template<typename DecisionTable>
+    struct auto_sorter;
     template<typename BufferProvider>
     struct block_sorter;
     struct counting_sorter;
     struct default_sorter;
     struct drop_merge_sorter;
+    template<typename Sorter>
+    struct external_sorter;
     struct float_spread_sorter;
     template<typename BufferProvider>
     struct grail_sorter;
     struct heap_sorter;
     struct insertion_sorter;
     struct integer_spread_sorter;
+    template<typename BufferProvider>
+    struct lsd_radix_sorter;
     struct merge_insertion_sorter;
     struct merge_sorter;
+    struct packed_string_sorter;
+    struct parallel_merge_sorter;
+    struct parallel_pdq_sorter;
+    struct parallel_ska_sorter;
+    struct parallel_tim_sorter;
+    struct parallel_verge_sorter;
     struct pdq_sorter;
     struct poplar_sorter;
     struct quick_merge_sorter;
@@ -84,6 +96,8 @@ namespace cppsort
     ////////////////////////////////////////////////////////////
     // Sorter adapters
 
+    template<typename Sorter>
+    struct buffered_adapter;
     template<typename Sorter>
     struct container_aware_adapter;
     template<typename Sorter, typename CountType=std::size_t>
@@ -0,0 +1,202 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef CPPSORT_INCREMENTAL_SORTER_H_
+#define CPPSORT_INCREMENTAL_SORTER_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <utility>
+#include <vector>
+#include <cpp-sort/sorters/default_sorter.h>
+#include <cpp-sort/utility/as_function.h>
+#include <cpp-sort/utility/functional.h>
+#include "detail/inplace_merge.h"
+#include "detail/timsort.h"
+
+namespace cppsort
+{
+    ////////////////////////////////////////////////////////////
+    // Sort data received in chunks
+
+    // Every chunk pushed to the sorter is sorted on arrival with
+    // the given sorter and becomes a run on a stack whose runs are
+    // merged with the same policy as timsort, which keeps the merges
+    // balanced: once the last chunk has been pushed, finish() only
+    // has to merge the few remaining runs
+    //
+    // The sorted elements can be iterated once finish() has been
+    // called, pushing more chunks afterwards is allowed as long
+    // as finish() is called again before iterating
+    template<
+        typename T,
+        typename Sorter = default_sorter,
+        typename Compare = std::less<>,
+        typename Projection = utility::identity
+    >
+    class incremental_sorter
+    {
+        private:
+
+            struct run
+            {
+                std::size_t base;
+                std::ptrdiff_t len;
+            };
+
+            std::vector<T> data_;
+            std::vector<run> pending_;
+            Sorter sorter_;
+            Compare compare_;
+            Projection projection_;
+
+        public:
+
+            using value_type = T;
+            using const_iterator = typename std::vector<T>::const_iterator;
+            using size_type = typename std::vector<T>::size_type;
+
+            incremental_sorter() = default;
+
+            explicit incremental_sorter(Sorter sorter, Compare compare={},
+                                        Projection projection={}):
+                sorter_(std::move(sorter)),
+                compare_(std::move(compare)),
+                projection_(std::move(projection))
+            {}
+
+            ////////////////////////////////////////////////////////////
+            // Chunks of data
+
+            template<typename InputIterator>
+            auto push(InputIterator first, InputIterator last)
+                -> void
+            {
+                auto base = data_.size();
+                data_.insert(data_.end(), first, last);
+                if (data_.size() == base) return;
+
+                auto run_first = data_.begin() + static_cast<std::ptrdiff_t>(base);
+                sorter_(run_first, data_.end(), compare_, projection_);
+
+                auto len = static_cast<std::ptrdiff_t>(data_.size() - base);
+                auto&& comp = utility::as_function(compare_);
+                auto&& proj = utility::as_function(projection_);
+                if (not pending_.empty() && not comp(proj(*run_first), proj(*std::prev(run_first)))) {
+                    // The chunk continues the previous run
+                    pending_.back().len += len;
+                } else {
+                    pending_.push_back({ base, len });
+                }
+
+                std::ptrdiff_t n;
+                while ((n = detail::timsort_collapse_index(pending_)) >= 0) {
+                    merge_at(n);
+                }
+            }
+
+            template<typename Iterable>
+            auto push(const Iterable& iterable)
+                -> void
+            {
+                using std::begin;
+                using std::end;
+                push(begin(iterable), end(iterable));
+            }
+
+            // Merges the pending runs, after which the
+            // elements can be iterated in sorted order
+            auto finish()
+                -> void
+            {
+                std::ptrdiff_t n;
+                while ((n = detail::timsort_force_collapse_index(pending_)) >= 0) {
+                    merge_at(n);
+                }
+            }
+
+            // Gives back the elements and leaves the sorter empty,
+            // they are only sorted if finish() was called before
+            auto release()
+                -> std::vector<T>
+            {
+                pending_.clear();
+                return std::move(data_);
+            }
+
+            ////////////////////////////////////////////////////////////
+            // Sorted elements
+
+            auto begin() const
+                -> const_iterator
+            {
+                return data_.begin();
+            }
+
+            auto end() const
+                -> const_iterator
+            {
+                return data_.end();
+            }
+
+            auto size() const
+                -> size_type
+            {
+                return data_.size();
+            }
+
+            auto empty() const
+                -> bool
+            {
+                return data_.empty();
+            }
+
+            // Number of sorted runs waiting to be merged
+            auto pending_runs() const
+                -> std::size_t
+            {
+                return pending_.size();
+            }
+
+        private:
+
+            auto merge_at(std::ptrdiff_t n)
+                -> void
+            {
+                auto idx = static_cast<std::size_t>(n);
+                auto first = data_.begin() + static_cast<std::ptrdiff_t>(pending_[idx].base);
+                auto middle = first + pending_[idx].len;
+                auto last = middle + pending_[idx + 1].len;
+                detail::inplace_merge(first, middle, last, compare_, projection_);
+
+                pending_[idx].len += pending_[idx + 1].len;
+                pending_.erase(pending_.begin() + n + 1);
+            }
+    };
+}
+
+#endif // CPPSORT_INCREMENTAL_SORTER_H_
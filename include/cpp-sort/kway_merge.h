@@ -0,0 +1,101 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef CPPSORT_KWAY_MERGE_H_
+#define CPPSORT_KWAY_MERGE_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <utility>
+#include <vector>
+#include <cpp-sort/utility/as_function.h>
+#include <cpp-sort/utility/functional.h>
+#include <cpp-sort/utility/iter_move.h>
+#include "detail/loser_tree.h"
+
+namespace cppsort
+{
+    ////////////////////////////////////////////////////////////
+    // Merge any number of sorted ranges
+
+    // Merges the sorted ranges of ranges into out with a tree of
+    // losers, which performs about log2(k) comparisons per element
+    // when merging k ranges; the merge is stable: equivalent
+    // elements are taken from the earliest range first
+    //
+    // The elements are moved out of the ranges, pass ranges
+    // of const elements to copy them instead
+    template<
+        typename Ranges,
+        typename OutputIterator,
+        typename Compare = std::less<>,
+        typename Projection = utility::identity
+    >
+    auto kway_merge(Ranges&& ranges, OutputIterator out,
+                    Compare compare={}, Projection projection={})
+        -> OutputIterator
+    {
+        using std::begin;
+        using std::end;
+        using utility::iter_move;
+        using iterator = decltype(begin(*begin(ranges)));
+        auto&& comp = utility::as_function(compare);
+        auto&& proj = utility::as_function(projection);
+
+        // Current position and end of every range
+        std::vector<std::pair<iterator, iterator>> sources;
+        for (auto&& range: ranges) {
+            sources.emplace_back(begin(range), end(range));
+        }
+        if (sources.empty()) {
+            return out;
+        }
+
+        auto tree = detail::make_loser_tree(sources.size(), [&](std::size_t lhs, std::size_t rhs) {
+            if (sources[lhs].first == sources[lhs].second) return false;
+            if (sources[rhs].first == sources[rhs].second) return true;
+            if (lhs < rhs) {
+                return not comp(proj(*sources[rhs].first), proj(*sources[lhs].first));
+            }
+            return bool(comp(proj(*sources[lhs].first), proj(*sources[rhs].first)));
+        });
+
+        // Exhausted sources lose against the other ones,
+        // so the merge ends when one of them wins
+        while (true) {
+            auto& source = sources[tree.winner()];
+            if (source.first == source.second) break;
+            *out = iter_move(source.first);
+            ++out;
+            ++source.first;
+            tree.replay();
+        }
+        return out;
+    }
+}
+
+#endif // CPPSORT_KWAY_MERGE_H_
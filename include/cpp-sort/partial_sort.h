@@ -0,0 +1,163 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef CPPSORT_PARTIAL_SORT_H_
+#define CPPSORT_PARTIAL_SORT_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <utility>
+#include <vector>
+#include <cpp-sort/utility/as_function.h>
+#include <cpp-sort/utility/functional.h>
+#include <cpp-sort/utility/size.h>
+#include "detail/heapsort.h"
+#include "detail/iterator_traits.h"
+#include "detail/nth_element.h"
+#include "detail/type_traits.h"
+
+namespace cppsort
+{
+    ////////////////////////////////////////////////////////////
+    // Selection
+
+    // Reorders the collection so that the element at position nth
+    // is the one that would be there if the collection was sorted,
+    // with no greater element before it and no smaller one after
+    // it, and returns an iterator to it
+    template<
+        typename ForwardIterable,
+        typename Compare = std::less<>,
+        typename Projection = utility::identity
+    >
+    auto nth_element(ForwardIterable&& iterable, std::size_t nth,
+                     Compare compare={}, Projection projection={})
+        -> decltype(std::begin(iterable))
+    {
+        using difference_type = detail::difference_type_t<decltype(std::begin(iterable))>;
+        auto size = static_cast<difference_type>(utility::size(iterable));
+        auto nth_pos = static_cast<difference_type>(nth);
+        if (nth_pos >= size) {
+            return std::end(iterable);
+        }
+        return detail::nth_element(std::begin(iterable), std::end(iterable), nth_pos, size,
+                                   std::move(compare), std::move(projection));
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Partial sort
+
+    // Puts the k smallest elements of the collection in sorted order
+    // at its beginning and returns the end of the sorted prefix: they
+    // are first isolated with introselect, then only them are sorted
+    // with the given sorter
+    template<
+        typename Sorter,
+        typename ForwardIterable,
+        typename Compare = std::less<>,
+        typename Projection = utility::identity
+    >
+    auto partial_sort(const Sorter& sorter, ForwardIterable&& iterable, std::size_t k,
+                      Compare compare={}, Projection projection={})
+        -> decltype(std::begin(iterable))
+    {
+        using difference_type = detail::difference_type_t<decltype(std::begin(iterable))>;
+        auto first = std::begin(iterable);
+        auto last = std::end(iterable);
+        auto size = static_cast<difference_type>(utility::size(iterable));
+        auto nb_sorted = static_cast<difference_type>(k);
+
+        if (nb_sorted >= size) {
+            sorter(first, last, std::move(compare), std::move(projection));
+            return last;
+        }
+        if (nb_sorted == 0) {
+            return first;
+        }
+
+        // The k-th smallest element is already in its final place
+        // once the collection is partitioned around it
+        auto kth = detail::nth_element(first, last, nb_sorted - 1, size, compare, projection);
+        sorter(first, kth, std::move(compare), std::move(projection));
+        return std::next(kth);
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Streaming top-k
+
+    // Writes the k smallest elements of the collection to out in
+    // sorted order with a single pass over the collection, which
+    // only needs to be an input range: a heap holds the k smallest
+    // elements seen so far, hence O(n log k) comparisons and only
+    // k elements of extra memory
+    template<
+        typename InputIterable,
+        typename OutputIterator,
+        typename Compare = std::less<>,
+        typename Projection = utility::identity
+    >
+    auto top_k(InputIterable&& iterable, std::size_t k, OutputIterator out,
+               Compare compare={}, Projection projection={})
+        -> OutputIterator
+    {
+        using value_type = detail::remove_cvref_t<decltype(*std::begin(iterable))>;
+        auto&& comp = utility::as_function(compare);
+        auto&& proj = utility::as_function(projection);
+
+        if (k == 0) {
+            return out;
+        }
+
+        std::vector<value_type> heap;
+        auto first = std::begin(iterable);
+        auto last = std::end(iterable);
+        for (; first != last && heap.size() < k ; ++first) {
+            heap.push_back(*first);
+        }
+        detail::make_heap(heap.begin(), heap.end(), compare, projection);
+
+        // Replace the greatest element of the heap every time
+        // a smaller element is found
+        auto len = static_cast<std::ptrdiff_t>(heap.size());
+        for (; first != last ; ++first) {
+            if (comp(proj(*first), proj(heap.front()))) {
+                heap.front() = *first;
+                detail::sift_down<Compare>(heap.begin(), heap.end(), compare, projection,
+                                           len, heap.begin());
+            }
+        }
+
+        detail::sort_heap(heap.begin(), heap.end(), compare, projection);
+        for (auto& elem: heap) {
+            *out = std::move(elem);
+            ++out;
+        }
+        return out;
+    }
+}
+
+#endif // CPPSORT_PARTIAL_SORT_H_
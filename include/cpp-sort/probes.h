@@ -27,6 +27,7 @@
 ////////////////////////////////////////////////////////////
 // Headers
 ////////////////////////////////////////////////////////////
+#include <cpp-sort/probes/approx.h>
 #include <cpp-sort/probes/dis.h>
 #include <cpp-sort/probes/enc.h>
 #include <cpp-sort/probes/exc.h>
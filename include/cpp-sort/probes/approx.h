@@ -0,0 +1,248 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef CPPSORT_PROBES_APPROX_H_
+#define CPPSORT_PROBES_APPROX_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <random>
+#include <type_traits>
+#include <utility>
+#include <cpp-sort/sorter_facade.h>
+#include <cpp-sort/sorter_traits.h>
+#include <cpp-sort/probes/enc.h>
+#include <cpp-sort/probes/exc.h>
+#include <cpp-sort/probes/ham.h>
+#include <cpp-sort/probes/inv.h>
+#include <cpp-sort/probes/max.h>
+#include <cpp-sort/probes/rem.h>
+#include <cpp-sort/utility/as_function.h>
+#include <cpp-sort/utility/functional.h>
+#include <cpp-sort/utility/static_const.h>
+#include "../detail/config.h"
+#include "../detail/iterator_traits.h"
+#include "../detail/memory.h"
+
+namespace cppsort
+{
+namespace probe
+{
+namespace approx
+{
+    //
+    // Approximate measures of presortedness
+    //
+    // These probes compute the corresponding exact measure on a
+    // sample of k elements of the collection, then scale the result
+    // to the size of the collection; they run in O(k log k) time and
+    // O(k) memory for random-access iterators, forward iterators
+    // additionally need a linear traversal to gather the sample.
+    // Collections that aren't bigger than the sample are measured
+    // exactly
+    //
+    // The sample is stratified: the collection is split into k
+    // equal slices and one element is picked at random in each of
+    // them, which keeps the sampled elements in their original
+    // order while not being fooled by periodic patterns
+    //
+
+    namespace detail
+    {
+        // Number of sampled elements when none is given
+        constexpr std::size_t default_sample_size = 1024;
+
+        ////////////////////////////////////////////////////////////
+        // Scaling of the measure computed on the sample
+
+        // Measures bounded by the number of pairs of elements
+        struct scale_pairs
+        {
+            template<typename Difference>
+            auto operator()(Difference value, Difference size, Difference sample_size) const
+                -> Difference
+            {
+                double factor = (static_cast<double>(size) * static_cast<double>(size - 1))
+                              / (static_cast<double>(sample_size) * static_cast<double>(sample_size - 1));
+                return static_cast<Difference>(static_cast<double>(value) * factor + 0.5);
+            }
+        };
+
+        // Measures bounded by the number of elements
+        struct scale_linear
+        {
+            template<typename Difference>
+            auto operator()(Difference value, Difference size, Difference sample_size) const
+                -> Difference
+            {
+                double factor = static_cast<double>(size) / static_cast<double>(sample_size);
+                return static_cast<Difference>(static_cast<double>(value) * factor + 0.5);
+            }
+        };
+
+        // Measures that don't grow with the size of a random sample,
+        // the result is a lower bound of the exact measure
+        struct scale_none
+        {
+            template<typename Difference>
+            auto operator()(Difference value, Difference, Difference) const
+                -> Difference
+            {
+                return value;
+            }
+        };
+
+        ////////////////////////////////////////////////////////////
+        // Projection applied to the sampled iterators
+
+        template<typename Projection>
+        struct sample_projection
+        {
+            Projection projection;
+
+            template<typename Iterator>
+            auto operator()(const Iterator& it) const
+                -> decltype(utility::as_function(projection)(*it))
+            {
+                return utility::as_function(projection)(*it);
+            }
+        };
+
+        ////////////////////////////////////////////////////////////
+        // Generic sampling probe
+
+        template<typename Probe, typename Scaling>
+        struct approx_probe_impl
+        {
+            std::size_t sample_size = default_sample_size;
+
+            approx_probe_impl() = default;
+
+            constexpr explicit approx_probe_impl(std::size_t sample_size) noexcept:
+                sample_size(sample_size < 2 ? 2 : sample_size)
+            {}
+
+            template<
+                typename ForwardIterator,
+                typename Compare = std::less<>,
+                typename Projection = utility::identity,
+                typename = std::enable_if_t<
+                    is_projection_iterator_v<Projection, ForwardIterator, Compare>
+                >
+            >
+            auto operator()(ForwardIterator first, ForwardIterator last,
+                            Compare compare={}, Projection projection={}) const
+                -> cppsort::detail::difference_type_t<ForwardIterator>
+            {
+                using difference_type = cppsort::detail::difference_type_t<ForwardIterator>;
+
+                auto size = std::distance(first, last);
+                auto nb_samples = static_cast<difference_type>(sample_size);
+                if (size <= nb_samples) {
+                    return Probe{}(std::move(first), std::move(last),
+                                   std::move(compare), std::move(projection));
+                }
+
+                // Pick one element in every slice, the engine is seeded
+                // with a constant to keep the results reproducible
+                cppsort::detail::temporary_vector<ForwardIterator> sample;
+                sample.reserve(sample_size);
+                std::minstd_rand engine;
+                difference_type pos = 0;
+                for (difference_type idx = 0 ; idx < nb_samples ; ++idx) {
+                    std::uniform_int_distribution<difference_type> dist(
+                        idx * size / nb_samples,
+                        (idx + 1) * size / nb_samples - 1
+                    );
+                    auto target = dist(engine);
+                    std::advance(first, target - pos);
+                    pos = target;
+                    sample.push_back(first);
+                }
+
+                auto res = Probe{}(
+                    sample.begin(), sample.end(), std::move(compare),
+                    sample_projection<Projection>{std::move(projection)}
+                );
+                return Scaling{}(static_cast<difference_type>(res), size, nb_samples);
+            }
+
+            ////////////////////////////////////////////////////////////
+            // Sorter traits
+
+            using iterator_category = std::forward_iterator_tag;
+        };
+    }
+
+    template<typename Probe, typename Scaling>
+    struct approx_probe:
+        sorter_facade<detail::approx_probe_impl<Probe, Scaling>>
+    {
+        approx_probe() = default;
+
+        constexpr explicit approx_probe(std::size_t sample_size) noexcept:
+            sorter_facade<detail::approx_probe_impl<Probe, Scaling>>(sample_size)
+        {}
+
+        // Picks a sample big enough for the normalized measure to be
+        // within max_error of the exact one with the given probability,
+        // according to Hoeffding's inequality
+        approx_probe(double max_error, double confidence):
+            approx_probe(sample_size_for(max_error, confidence))
+        {}
+
+        static auto sample_size_for(double max_error, double confidence)
+            -> std::size_t
+        {
+            CPPSORT_ASSERT(max_error > 0.0 && max_error < 1.0);
+            CPPSORT_ASSERT(confidence > 0.0 && confidence < 1.0);
+            return static_cast<std::size_t>(std::ceil(
+                std::log(2.0 / (1.0 - confidence)) / (2.0 * max_error * max_error)
+            ));
+        }
+    };
+
+    using enc_probe = approx_probe<probe::detail::enc_impl, detail::scale_none>;
+    using exc_probe = approx_probe<probe::detail::exc_impl, detail::scale_linear>;
+    using ham_probe = approx_probe<probe::detail::ham_impl, detail::scale_linear>;
+    using inv_probe = approx_probe<probe::detail::inv_impl, detail::scale_pairs>;
+    using max_probe = approx_probe<probe::detail::max_impl, detail::scale_linear>;
+    using rem_probe = approx_probe<probe::detail::rem_impl, detail::scale_linear>;
+
+    namespace
+    {
+        constexpr auto&& enc = utility::static_const<enc_probe>::value;
+        constexpr auto&& exc = utility::static_const<exc_probe>::value;
+        constexpr auto&& ham = utility::static_const<ham_probe>::value;
+        constexpr auto&& inv = utility::static_const<inv_probe>::value;
+        constexpr auto&& max = utility::static_const<max_probe>::value;
+        constexpr auto&& rem = utility::static_const<rem_probe>::value;
+    }
+}}}
+
+#endif // CPPSORT_PROBES_APPROX_H_
@@ -37,6 +37,7 @@
 #include <cpp-sort/utility/functional.h>
 #include <cpp-sort/utility/static_const.h>
 #include "../detail/iterator_traits.h"
+#include "../detail/memory.h"
 
 namespace cppsort
 {
@@ -62,23 +63,43 @@ namespace probe
                 auto&& comp = utility::as_function(compare);
                 auto&& proj = utility::as_function(projection);
 
-                if (first == last || std::next(first) == last)
-                {
+                auto size = std::distance(first, last);
+                if (size < 2) {
                     return 0;
                 }
 
+                // The result is the biggest distance between two elements
+                // that form an inversion; for every position j, find an
+                // iterator to the smallest element of [first + j, last)
+                cppsort::detail::temporary_vector<ForwardIterator> suffix_min;
+                suffix_min.reserve(size);
+                for (auto it = first ; it != last ; ++it) {
+                    suffix_min.push_back(it);
+                }
+                for (auto idx = size - 1 ; idx > 0 ; --idx) {
+                    if (comp(proj(*suffix_min[idx]), proj(*suffix_min[idx - 1]))) {
+                        suffix_min[idx - 1] = suffix_min[idx];
+                    }
+                }
+
+                // Both the prefix maximums and the suffix minimums are
+                // sorted, which allows to find the farthest inversion
+                // with a single pass over each of them: whenever the
+                // minimum of [j, last) is smaller than the maximum of
+                // [first, i], there is an inversion spanning [i, j]
                 difference_type max_dist = 0;
-                for (auto it1 = first ; it1 != last ; ++it1)
-                {
-                    auto&& value = proj(*it1);
-                    for (auto it2 = std::next(it1) ; it2 != last ; ++it2)
-                    {
-                        if (comp(proj(*it2), value))
-                        {
-                            max_dist = std::max(
-                                max_dist,
-                                std::distance(it1, it2)
-                            );
+                auto it_max = first;
+                auto it = first;
+                difference_type i = 0;
+                difference_type j = 0;
+                while (j != size) {
+                    if (comp(proj(*suffix_min[j]), proj(*it_max))) {
+                        max_dist = std::max(max_dist, j - i);
+                        ++j;
+                    } else {
+                        if (++i == size) break;
+                        if (comp(proj(*it_max), proj(*++it))) {
+                            it_max = it;
                         }
                     }
                 }
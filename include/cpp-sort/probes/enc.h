@@ -31,13 +31,13 @@
 #include <iterator>
 #include <type_traits>
 #include <utility>
-#include <vector>
 #include <cpp-sort/sorter_facade.h>
 #include <cpp-sort/sorter_traits.h>
 #include <cpp-sort/utility/as_function.h>
 #include <cpp-sort/utility/functional.h>
 #include <cpp-sort/utility/static_const.h>
 #include "../detail/iterator_traits.h"
+#include "../detail/memory.h"
 
 namespace cppsort
 {
@@ -63,7 +63,7 @@ namespace probe
                 auto&& proj = utility::as_function(projection);
 
                 // Head an tail of encroaching lists
-                std::vector<std::pair<ForwardIterator, ForwardIterator>> lists;
+                cppsort::detail::temporary_vector<std::pair<ForwardIterator, ForwardIterator>> lists;
 
                 while (first != last) {
                     auto&& value = proj(*first);
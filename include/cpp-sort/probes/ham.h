@@ -31,7 +31,6 @@
 #include <iterator>
 #include <type_traits>
 #include <utility>
-#include <vector>
 #include <cpp-sort/sorter_facade.h>
 #include <cpp-sort/sorter_traits.h>
 #include <cpp-sort/utility/as_function.h>
@@ -39,6 +38,7 @@
 #include <cpp-sort/utility/static_const.h>
 #include "../detail/indirect_compare.h"
 #include "../detail/iterator_traits.h"
+#include "../detail/memory.h"
 #include "../detail/pdqsort.h"
 
 namespace cppsort
@@ -74,7 +74,7 @@ namespace probe
                 // Indirectly sort the iterators
 
                 // Copy the iterators in a vector
-                std::vector<ForwardIterator> iterators;
+                cppsort::detail::temporary_vector<ForwardIterator> iterators;
                 iterators.reserve(size);
                 for (ForwardIterator it = first ; it != last ; ++it) {
                     iterators.push_back(it);
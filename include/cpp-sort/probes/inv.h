@@ -29,7 +29,6 @@
 ////////////////////////////////////////////////////////////
 #include <functional>
 #include <iterator>
-#include <memory>
 #include <type_traits>
 #include <utility>
 #include <cpp-sort/sorter_facade.h>
@@ -39,6 +38,7 @@
 #include "../detail/count_inversions.h"
 #include "../detail/indirect_compare.h"
 #include "../detail/iterator_traits.h"
+#include "../detail/memory.h"
 
 namespace cppsort
 {
@@ -67,16 +67,16 @@ namespace probe
                     return 0;
                 }
 
-                auto iterators = std::make_unique<ForwardIterator[]>(size);
-                auto buffer = std::make_unique<ForwardIterator[]>(size);
+                cppsort::detail::temporary_vector<ForwardIterator> iterators(size);
+                cppsort::detail::temporary_vector<ForwardIterator> buffer(size);
 
-                auto store = iterators.get();
+                auto store = iterators.data();
                 for (ForwardIterator it = first ; it != last ; ++it) {
                     *store++ = it;
                 }
 
                 return cppsort::detail::count_inversions<difference_type>(
-                    iterators.get(), iterators.get() + size, buffer.get(),
+                    iterators.data(), iterators.data() + size, buffer.data(),
                     cppsort::detail::indirect_compare<Compare, Projection>(std::move(compare),
                                                                            std::move(projection))
                 );
@@ -32,7 +32,6 @@
 #include <iterator>
 #include <type_traits>
 #include <utility>
-#include <vector>
 #include <cpp-sort/sorter_facade.h>
 #include <cpp-sort/sorter_traits.h>
 #include <cpp-sort/utility/as_function.h>
@@ -41,6 +40,7 @@
 #include "../detail/equal_range.h"
 #include "../detail/indirect_compare.h"
 #include "../detail/iterator_traits.h"
+#include "../detail/memory.h"
 #include "../detail/pdqsort.h"
 
 namespace cppsort
@@ -75,7 +75,7 @@ namespace probe
                 // Indirectly sort the iterators
 
                 // Copy the iterators in a vector
-                std::vector<ForwardIterator> iterators;
+                cppsort::detail::temporary_vector<ForwardIterator> iterators;
                 iterators.reserve(size);
                 for (ForwardIterator it = first ; it != last ; ++it) {
                     iterators.push_back(it);
@@ -27,16 +27,21 @@
 ////////////////////////////////////////////////////////////
 // Headers
 ////////////////////////////////////////////////////////////
-#include <algorithm>
 #include <functional>
 #include <iterator>
 #include <type_traits>
+#include <utility>
 #include <cpp-sort/sorter_facade.h>
 #include <cpp-sort/sorter_traits.h>
 #include <cpp-sort/utility/as_function.h>
 #include <cpp-sort/utility/functional.h>
 #include <cpp-sort/utility/static_const.h>
+#include "../detail/indirect_compare.h"
 #include "../detail/iterator_traits.h"
+#include "../detail/lower_bound.h"
+#include "../detail/memory.h"
+#include "../detail/pdqsort.h"
+#include "../detail/upper_bound.h"
 
 namespace cppsort
 {
@@ -62,30 +67,59 @@ namespace probe
                 auto&& comp = utility::as_function(compare);
                 auto&& proj = utility::as_function(projection);
 
-                if (first == last || std::next(first) == last)
-                {
+                auto size = std::distance(first, last);
+                if (size < 2) {
                     return 0;
                 }
 
-                difference_type count = 0;
-                for (auto it = first ; it != last ; ++it)
-                {
-                    auto&& value = proj(*it);
+                ////////////////////////////////////////////////////////////
+                // Indirectly sort the iterators
+
+                cppsort::detail::temporary_vector<ForwardIterator> iterators;
+                iterators.reserve(size);
+                for (ForwardIterator it = first ; it != last ; ++it) {
+                    iterators.push_back(it);
+                }
+
+                cppsort::detail::pdqsort(
+                    iterators.begin(), iterators.end(),
+                    cppsort::detail::indirect_compare<Compare, Projection>(compare, projection),
+                    utility::identity{}
+                );
 
-                    auto current = first;
-                    auto next = std::next(first);
+                ////////////////////////////////////////////////////////////
+                // Every pair of adjacent elements crosses the values that
+                // are strictly between them, which can be counted with two
+                // binary searches in the sorted sequence
 
-                    while (next != last)
-                    {
-                        if (comp(std::min(proj(*current), proj(*next)), value) &&
-                            comp(value, std::max(proj(*current), proj(*next))))
-                        {
-                            ++count;
-                        }
+                auto deref_proj = [&proj](const auto& iterator) -> decltype(auto) {
+                    return proj(*iterator);
+                };
 
-                        ++current;
-                        ++next;
+                difference_type count = 0;
+                auto current = first;
+                auto next = std::next(first);
+                while (next != last) {
+                    auto low = current;
+                    auto high = next;
+                    if (comp(proj(*high), proj(*low))) {
+                        std::swap(low, high);
+                    }
+
+                    if (comp(proj(*low), proj(*high))) {
+                        auto begin_crossed = cppsort::detail::upper_bound(
+                            iterators.begin(), iterators.end(), proj(*low),
+                            compare, deref_proj
+                        );
+                        auto end_crossed = cppsort::detail::lower_bound(
+                            begin_crossed, iterators.end(), proj(*high),
+                            compare, deref_proj
+                        );
+                        count += end_crossed - begin_crossed;
                     }
+
+                    ++current;
+                    ++next;
                 }
                 return count;
             }
@@ -30,11 +30,12 @@
 #include <functional>
 #include <iterator>
 #include <type_traits>
+#include <utility>
 #include <cpp-sort/sorter_facade.h>
 #include <cpp-sort/sorter_traits.h>
 #include <cpp-sort/utility/functional.h>
 #include <cpp-sort/utility/static_const.h>
-#include "../detail/is_p_sorted.h"
+#include "dis.h"
 
 namespace cppsort
 {
@@ -56,20 +57,10 @@ namespace probe
                             Compare compare={}, Projection projection={}) const
                 -> cppsort::detail::difference_type_t<RandomAccessIterator>
             {
-                auto size = std::distance(first, last);
-
-                auto res = 0;
-                while (size > 0) {
-                    auto p = res;
-                    p += size / 2;
-                    if (cppsort::detail::is_p_sorted(first, last, p, compare, projection)) {
-                        size /= 2;
-                    } else {
-                        res = ++p;
-                        size -= size / 2 + 1;
-                    }
-                }
-                return res;
+                // Par(X) and Dis(X) are equal: a sequence is p-sorted
+                // when all of its inversions span at most p positions
+                return dis_impl{}(std::move(first), std::move(last),
+                                  std::move(compare), std::move(projection));
             }
         };
     }
@@ -30,13 +30,13 @@
 #include <functional>
 #include <iterator>
 #include <type_traits>
-#include <vector>
 #include <cpp-sort/sorter_facade.h>
 #include <cpp-sort/sorter_traits.h>
 #include <cpp-sort/utility/as_function.h>
 #include <cpp-sort/utility/functional.h>
 #include <cpp-sort/utility/static_const.h>
 #include "../detail/iterator_traits.h"
+#include "../detail/memory.h"
 #include "../detail/upper_bound.h"
 
 namespace cppsort
@@ -79,7 +79,7 @@ namespace probe
                 auto&& proj = utility::as_function(projection);
 
                 // Top (smaller) elements in patience sorting stacks
-                std::vector<ForwardIterator> stack_tops;
+                cppsort::detail::temporary_vector<ForwardIterator> stack_tops;
 
                 auto deref_compare = [&](const auto& lhs, auto rhs_it) mutable {
                     return comp(lhs, *rhs_it);
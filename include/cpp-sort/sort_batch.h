@@ -0,0 +1,72 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef CPPSORT_SORT_BATCH_H_
+#define CPPSORT_SORT_BATCH_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <utility>
+#include <cpp-sort/utility/functional.h>
+#include "detail/sort_batch.h"
+
+namespace cppsort
+{
+    ////////////////////////////////////////////////////////////
+    // Sort many independent segments of a collection
+
+    // Sorts every segment of a flat collection independently, the
+    // segments being described by a range of n+1 offsets: segment i
+    // spans [offsets[i], offsets[i+1]) in the collection
+    //
+    // Segments of at most 32 arithmetic values compared with the
+    // default comparison and projection are grouped by size and
+    // sorted several at once by the sorting networks, with one
+    // segment per vector lane; the other segments are sorted by the
+    // given sorter. The work is split between nb_threads threads
+    // (0 meaning as many as the hardware supports) when the batch
+    // is big enough
+    template<
+        typename Sorter,
+        typename RandomAccessIterable,
+        typename Offsets,
+        typename Compare = std::less<>,
+        typename Projection = utility::identity
+    >
+    auto sort_batch(const Sorter& sorter, RandomAccessIterable&& collection,
+                    const Offsets& offsets, Compare compare={},
+                    Projection projection={}, std::size_t nb_threads=0)
+        -> void
+    {
+        using std::begin;
+        using std::end;
+        detail::sort_batch(sorter, begin(collection), begin(offsets), end(offsets),
+                           std::move(compare), std::move(projection), nb_threads);
+    }
+}
+
+#endif // CPPSORT_SORT_BATCH_H_
@@ -27,15 +27,24 @@
 ////////////////////////////////////////////////////////////
 // Headers
 ////////////////////////////////////////////////////////////
+#include <cpp-sort/sorters/auto_sorter.h>
 #include <cpp-sort/sorters/block_sorter.h>
 #include <cpp-sort/sorters/counting_sorter.h>
 #include <cpp-sort/sorters/default_sorter.h>
 #include <cpp-sort/sorters/drop_merge_sorter.h>
+#include <cpp-sort/sorters/external_sorter.h>
 #include <cpp-sort/sorters/grail_sorter.h>
 #include <cpp-sort/sorters/heap_sorter.h>
 #include <cpp-sort/sorters/insertion_sorter.h>
+#include <cpp-sort/sorters/lsd_radix_sorter.h>
 #include <cpp-sort/sorters/merge_insertion_sorter.h>
 #include <cpp-sort/sorters/merge_sorter.h>
+#include <cpp-sort/sorters/packed_string_sorter.h>
+#include <cpp-sort/sorters/parallel_merge_sorter.h>
+#include <cpp-sort/sorters/parallel_pdq_sorter.h>
+#include <cpp-sort/sorters/parallel_ska_sorter.h>
+#include <cpp-sort/sorters/parallel_tim_sorter.h>
+#include <cpp-sort/sorters/parallel_verge_sorter.h>
 #include <cpp-sort/sorters/pdq_sorter.h>
 #include <cpp-sort/sorters/poplar_sorter.h>
 #include <cpp-sort/sorters/quick_merge_sorter.h>
@@ -0,0 +1,284 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef CPPSORT_SORTERS_AUTO_SORTER_H_
+#define CPPSORT_SORTERS_AUTO_SORTER_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <cpp-sort/sorter_facade.h>
+#include <cpp-sort/sorter_traits.h>
+#include <cpp-sort/sorters/insertion_sorter.h>
+#include <cpp-sort/sorters/pdq_sorter.h>
+#include <cpp-sort/sorters/ska_sorter.h>
+#include <cpp-sort/sorters/spread_sorter/string_spread_sorter.h>
+#include <cpp-sort/sorters/verge_sorter.h>
+#include <cpp-sort/utility/adapter_storage.h>
+#include <cpp-sort/utility/as_function.h>
+#include <cpp-sort/utility/functional.h>
+#include <cpp-sort/utility/static_const.h>
+#include "../detail/iterator_traits.h"
+
+namespace cppsort
+{
+    ////////////////////////////////////////////////////////////
+    // Decision table
+
+    // Algorithms that auto_sorter can dispatch to
+    enum struct auto_sorter_choice
+    {
+        insertion_sort,
+        verge_sort,
+        ska_sort,
+        string_spread_sort,
+        pdq_sort
+    };
+
+    // Information gathered by auto_sorter before sorting, the
+    // statistics are computed with a single pass over the data
+    struct auto_sorter_stats
+    {
+        // Number of elements to sort
+        std::size_t size;
+        // Number of maximal ascending or descending runs
+        std::size_t nb_runs;
+        // Number of adjacent elements that compare equivalent
+        std::size_t nb_equal_neighbours;
+        // Whether the collection can be sorted with ska_sorter
+        // and string_spread_sorter respectively
+        bool radix_sortable;
+        bool string_sortable;
+    };
+
+    struct default_auto_sorter_table
+    {
+        auto operator()(const auto_sorter_stats& stats) const noexcept
+            -> auto_sorter_choice
+        {
+            if (stats.size < 32) {
+                return auto_sorter_choice::insertion_sort;
+            }
+            // Long runs on average: merging them is cheaper
+            // than sorting the collection from scratch
+            if (stats.nb_runs <= stats.size / 64) {
+                return auto_sorter_choice::verge_sort;
+            }
+            if (stats.string_sortable) {
+                return auto_sorter_choice::string_spread_sort;
+            }
+            if (stats.radix_sortable) {
+                return auto_sorter_choice::ska_sort;
+            }
+            return auto_sorter_choice::pdq_sort;
+        }
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Sorter
+
+    namespace detail
+    {
+        template<typename Sorter, typename RandomAccessIterator,
+                 typename Compare, typename Projection>
+        auto auto_sort_with(std::true_type, RandomAccessIterator first, RandomAccessIterator last,
+                            Compare compare, Projection projection)
+            -> void
+        {
+            Sorter{}(std::move(first), std::move(last),
+                     std::move(compare), std::move(projection));
+        }
+
+        template<typename Sorter, typename RandomAccessIterator,
+                 typename Compare, typename Projection>
+        auto auto_sort_with(std::false_type, RandomAccessIterator first, RandomAccessIterator last,
+                            Compare compare, Projection projection)
+            -> void
+        {
+            // The decision table picked an algorithm that can't
+            // handle the collection, fall back to pdqsort
+            pdq_sorter{}(std::move(first), std::move(last),
+                         std::move(compare), std::move(projection));
+        }
+
+        template<typename DecisionTable>
+        struct auto_sorter_impl:
+            utility::adapter_storage<DecisionTable>
+        {
+            auto_sorter_impl() = default;
+
+            constexpr explicit auto_sorter_impl(DecisionTable table):
+                utility::adapter_storage<DecisionTable>(std::move(table))
+            {}
+
+            template<
+                typename RandomAccessIterator,
+                typename Compare = std::less<>,
+                typename Projection = utility::identity,
+                typename = std::enable_if_t<
+                    is_projection_iterator_v<Projection, RandomAccessIterator, Compare>
+                >
+            >
+            auto operator()(RandomAccessIterator first, RandomAccessIterator last,
+                            Compare compare={}, Projection projection={}) const
+                -> void
+            {
+                static_assert(
+                    std::is_base_of<
+                        std::random_access_iterator_tag,
+                        iterator_category_t<RandomAccessIterator>
+                    >::value,
+                    "auto_sorter requires at least random-access iterators"
+                );
+
+                using radix_sortable = std::integral_constant<bool,
+                    is_comparison_projection_sorter_iterator_v<
+                        ska_sorter, RandomAccessIterator, Compare, Projection
+                    >
+                >;
+                using string_sortable = std::integral_constant<bool,
+                    is_comparison_projection_sorter_iterator_v<
+                        string_spread_sorter, RandomAccessIterator, Compare, Projection
+                    >
+                >;
+
+                auto_sorter_stats stats = compute_stats(first, last, compare, projection);
+                stats.radix_sortable = radix_sortable::value;
+                stats.string_sortable = string_sortable::value;
+
+                switch (this->get()(static_cast<const auto_sorter_stats&>(stats))) {
+                    case auto_sorter_choice::insertion_sort:
+                        insertion_sorter{}(std::move(first), std::move(last),
+                                           std::move(compare), std::move(projection));
+                        return;
+                    case auto_sorter_choice::verge_sort:
+                        verge_sorter{}(std::move(first), std::move(last),
+                                       std::move(compare), std::move(projection));
+                        return;
+                    case auto_sorter_choice::ska_sort:
+                        auto_sort_with<ska_sorter>(radix_sortable{},
+                                                   std::move(first), std::move(last),
+                                                   std::move(compare), std::move(projection));
+                        return;
+                    case auto_sorter_choice::string_spread_sort:
+                        auto_sort_with<string_spread_sorter>(string_sortable{},
+                                                             std::move(first), std::move(last),
+                                                             std::move(compare), std::move(projection));
+                        return;
+                    default:
+                        pdq_sorter{}(std::move(first), std::move(last),
+                                     std::move(compare), std::move(projection));
+                        return;
+                }
+            }
+
+            ////////////////////////////////////////////////////////////
+            // Sorter traits
+
+            using iterator_category = std::random_access_iterator_tag;
+            using is_always_stable = std::false_type;
+
+        private:
+
+            template<typename RandomAccessIterator, typename Compare, typename Projection>
+            static auto compute_stats(RandomAccessIterator first, RandomAccessIterator last,
+                                      Compare compare, Projection projection)
+                -> auto_sorter_stats
+            {
+                auto&& comp = utility::as_function(compare);
+                auto&& proj = utility::as_function(projection);
+
+                auto_sorter_stats stats = {};
+                stats.size = static_cast<std::size_t>(std::distance(first, last));
+                if (stats.size < 2) {
+                    stats.nb_runs = stats.size;
+                    return stats;
+                }
+
+                // Split the collection into maximal monotonic runs: a
+                // new run starts when the direction changes, and the
+                // direction of the new run is decided by the first two
+                // of its elements that don't compare equivalent
+                stats.nb_runs = 1;
+                int direction = 0;
+                for (auto next = std::next(first) ; next != last ; ++first, ++next) {
+                    int step = 0;
+                    if (comp(proj(*next), proj(*first))) {
+                        step = -1;
+                    } else if (comp(proj(*first), proj(*next))) {
+                        step = 1;
+                    } else {
+                        ++stats.nb_equal_neighbours;
+                        continue;
+                    }
+
+                    if (direction == 0) {
+                        direction = step;
+                    } else if (step != direction) {
+                        ++stats.nb_runs;
+                        direction = 0;
+                    }
+                }
+                return stats;
+            }
+        };
+    }
+
+    //
+    // Sorter picking the algorithm best suited to the collection at
+    // runtime: a single pass gathers statistics about the data, then
+    // the decision table maps them to one of the algorithms listed in
+    // auto_sorter_choice. The table can be replaced by any function
+    // object taking an auto_sorter_stats and returning a choice, which
+    // also makes it the natural place to report the chosen algorithm;
+    // choices that can't sort the given collection fall back to
+    // pdq_sorter
+    //
+
+    template<typename DecisionTable=default_auto_sorter_table>
+    struct auto_sorter:
+        sorter_facade<detail::auto_sorter_impl<DecisionTable>>
+    {
+        auto_sorter() = default;
+
+        constexpr explicit auto_sorter(DecisionTable table):
+            sorter_facade<detail::auto_sorter_impl<DecisionTable>>(std::move(table))
+        {}
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Sort function
+
+    namespace
+    {
+        constexpr auto&& auto_sort
+            = utility::static_const<auto_sorter<>>::value;
+    }
+}
+
+#endif // CPPSORT_SORTERS_AUTO_SORTER_H_
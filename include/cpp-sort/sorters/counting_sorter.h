@@ -32,6 +32,8 @@
 #include <type_traits>
 #include <utility>
 #include <cpp-sort/sorter_facade.h>
+#include <cpp-sort/sorter_traits.h>
+#include <cpp-sort/utility/functional.h>
 #include <cpp-sort/utility/static_const.h>
 #include "../detail/counting_sort.h"
 #include "../detail/iterator_traits.h"
@@ -80,6 +82,48 @@ namespace cppsort
                 reverse_counting_sort(std::move(first), std::move(last));
             }
 
+            template<typename ForwardIterator, typename Projection>
+            auto operator()(ForwardIterator first, ForwardIterator last,
+                            Projection projection) const
+                -> std::enable_if_t<
+                    is_projection_iterator_v<Projection, ForwardIterator> &&
+                    not std::is_same<Projection, utility::identity>::value &&
+                    detail::is_integral<projected_t<ForwardIterator, Projection>>::value
+                >
+            {
+                static_assert(
+                    std::is_base_of<
+                        std::forward_iterator_tag,
+                        iterator_category_t<ForwardIterator>
+                    >::value,
+                    "counting_sorter requires at least forward iterators"
+                );
+
+                counting_sort(std::move(first), std::move(last),
+                              std::less<>{}, std::move(projection));
+            }
+
+            template<typename ForwardIterator, typename Projection>
+            auto operator()(ForwardIterator first, ForwardIterator last,
+                            std::greater<> compare, Projection projection) const
+                -> std::enable_if_t<
+                    is_projection_iterator_v<Projection, ForwardIterator, std::greater<>> &&
+                    not std::is_same<Projection, utility::identity>::value &&
+                    detail::is_integral<projected_t<ForwardIterator, Projection>>::value
+                >
+            {
+                static_assert(
+                    std::is_base_of<
+                        std::forward_iterator_tag,
+                        iterator_category_t<ForwardIterator>
+                    >::value,
+                    "counting_sorter requires at least forward iterators"
+                );
+
+                counting_sort(std::move(first), std::move(last),
+                              compare, std::move(projection));
+            }
+
             ////////////////////////////////////////////////////////////
             // Sorter traits
 
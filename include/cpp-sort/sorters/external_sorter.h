@@ -0,0 +1,147 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef CPPSORT_SORTERS_EXTERNAL_SORTER_H_
+#define CPPSORT_SORTERS_EXTERNAL_SORTER_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <cpp-sort/sorter_facade.h>
+#include <cpp-sort/sorter_traits.h>
+#include <cpp-sort/sorters/pdq_sorter.h>
+#include <cpp-sort/utility/adapter_storage.h>
+#include <cpp-sort/utility/functional.h>
+#include <cpp-sort/utility/static_const.h>
+#include "../detail/checkers.h"
+#include "../detail/external_sort.h"
+#include "../detail/iterator_traits.h"
+
+namespace cppsort
+{
+    ////////////////////////////////////////////////////////////
+    // Sorter
+
+    namespace detail
+    {
+        template<typename Sorter>
+        struct external_sorter_impl:
+            utility::adapter_storage<Sorter>,
+            check_is_always_stable<Sorter>
+        {
+            // Maximum number of bytes used to hold elements in memory,
+            // bigger collections are sorted by runs spilled to disk
+            std::size_t memory_budget = std::size_t(256) * 1024 * 1024;
+            // Directory where the temporary files are created, the
+            // default temporary directory is used when it is null
+            const char* temporary_directory = nullptr;
+
+            external_sorter_impl() = default;
+
+            constexpr external_sorter_impl(std::size_t memory_budget,
+                                           const char* temporary_directory,
+                                           Sorter&& sorter):
+                utility::adapter_storage<Sorter>(std::move(sorter)),
+                memory_budget(memory_budget),
+                temporary_directory(temporary_directory)
+            {}
+
+            template<
+                typename RandomAccessIterator,
+                typename Compare = std::less<>,
+                typename Projection = utility::identity,
+                typename = std::enable_if_t<
+                    is_projection_iterator_v<Projection, RandomAccessIterator, Compare> &&
+                    std::is_trivially_copyable<value_type_t<RandomAccessIterator>>::value
+                >
+            >
+            auto operator()(RandomAccessIterator first, RandomAccessIterator last,
+                            Compare compare={}, Projection projection={}) const
+                -> void
+            {
+                static_assert(
+                    std::is_base_of<
+                        std::random_access_iterator_tag,
+                        iterator_category_t<RandomAccessIterator>
+                    >::value,
+                    "external_sorter requires at least random-access iterators"
+                );
+
+                external_sort(std::move(first), std::move(last),
+                              memory_budget, temporary_directory,
+                              this->get(), std::move(compare), std::move(projection));
+            }
+
+            ////////////////////////////////////////////////////////////
+            // Sorter traits
+
+            using iterator_category = std::random_access_iterator_tag;
+        };
+    }
+
+    //
+    // Collections bigger than the memory budget are sorted by runs
+    // written to temporary files, then merged back into the original
+    // collection. The I/O errors are reported with std::system_error:
+    // the original collection is left untouched when such an error
+    // happens while the runs are written, but an error during the
+    // final merge leaves it with some of its elements overwritten.
+    //
+    // The temporary directory is not copied: the string has to live
+    // as long as the sorter is used.
+    //
+
+    template<typename Sorter=pdq_sorter>
+    struct external_sorter:
+        sorter_facade<detail::external_sorter_impl<Sorter>>
+    {
+        external_sorter() = default;
+
+        constexpr explicit external_sorter(std::size_t memory_budget, Sorter sorter={}):
+            sorter_facade<detail::external_sorter_impl<Sorter>>(memory_budget, nullptr, std::move(sorter))
+        {}
+
+        constexpr external_sorter(std::size_t memory_budget, const char* temporary_directory,
+                                  Sorter sorter={}):
+            sorter_facade<detail::external_sorter_impl<Sorter>>(
+                memory_budget, temporary_directory, std::move(sorter)
+            )
+        {}
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Sort function
+
+    namespace
+    {
+        constexpr auto&& external_sort
+            = utility::static_const<external_sorter<>>::value;
+    }
+}
+
+#endif // CPPSORT_SORTERS_EXTERNAL_SORTER_H_
@@ -0,0 +1,118 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef CPPSORT_SORTERS_PACKED_STRING_SORTER_H_
+#define CPPSORT_SORTERS_PACKED_STRING_SORTER_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <iterator>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <cpp-sort/sorter_facade.h>
+#include <cpp-sort/sorter_traits.h>
+#include <cpp-sort/utility/functional.h>
+#include <cpp-sort/utility/static_const.h>
+#include "../detail/iterator_traits.h"
+#include "../detail/packed_string_sort.h"
+#include "../detail/type_traits.h"
+
+#if __cplusplus > 201402L && __has_include(<string_view>)
+#   include <string_view>
+#endif
+
+namespace cppsort
+{
+    ////////////////////////////////////////////////////////////
+    // Sorter
+
+    namespace detail
+    {
+        // The sorter keeps pointers to the characters of the strings,
+        // which thus have to outlive the projection call: either the
+        // projection returns an lvalue reference to a std::string, or
+        // it returns a std::string_view
+        template<typename RandomAccessIterator, typename Projection>
+        using is_packed_string_sortable = disjunction<
+            conjunction<
+                std::is_same<projected_t<RandomAccessIterator, Projection>, std::string>,
+                std::is_lvalue_reference<
+                    invoke_result_t<Projection, decltype(*std::declval<RandomAccessIterator&>())>
+                >
+            >
+#if __cplusplus > 201402L && __has_include(<string_view>)
+            , std::is_same<projected_t<RandomAccessIterator, Projection>, std::string_view>
+#endif
+        >;
+
+        struct packed_string_sorter_impl
+        {
+            template<
+                typename RandomAccessIterator,
+                typename Projection = utility::identity,
+                typename = std::enable_if_t<
+                    is_projection_iterator_v<Projection, RandomAccessIterator>
+                >
+            >
+            auto operator()(RandomAccessIterator first, RandomAccessIterator last,
+                            Projection projection={}) const
+                -> std::enable_if_t<
+                    is_packed_string_sortable<RandomAccessIterator, Projection>::value
+                >
+            {
+                static_assert(
+                    std::is_base_of<
+                        std::random_access_iterator_tag,
+                        iterator_category_t<RandomAccessIterator>
+                    >::value,
+                    "packed_string_sorter requires at least random-access iterators"
+                );
+
+                packed_string_sort(std::move(first), std::move(last), std::move(projection));
+            }
+
+            ////////////////////////////////////////////////////////////
+            // Sorter traits
+
+            using iterator_category = std::random_access_iterator_tag;
+            using is_always_stable = std::false_type;
+        };
+    }
+
+    struct packed_string_sorter:
+        sorter_facade<detail::packed_string_sorter_impl>
+    {};
+
+    ////////////////////////////////////////////////////////////
+    // Sort function
+
+    namespace
+    {
+        constexpr auto&& packed_string_sort
+            = utility::static_const<packed_string_sorter>::value;
+    }
+}
+
+#endif // CPPSORT_SORTERS_PACKED_STRING_SORTER_H_
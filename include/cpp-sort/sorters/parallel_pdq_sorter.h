@@ -0,0 +1,130 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef CPPSORT_SORTERS_PARALLEL_PDQ_SORTER_H_
+#define CPPSORT_SORTERS_PARALLEL_PDQ_SORTER_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <cpp-sort/adapters/stable_adapter.h>
+#include <cpp-sort/sorter_facade.h>
+#include <cpp-sort/sorter_traits.h>
+#include <cpp-sort/sorters/parallel_merge_sorter.h>
+#include <cpp-sort/utility/functional.h>
+#include <cpp-sort/utility/static_const.h>
+#include "../detail/iterator_traits.h"
+#include "../detail/parallel_pdqsort.h"
+
+namespace cppsort
+{
+    ////////////////////////////////////////////////////////////
+    // Sorter
+
+    namespace detail
+    {
+        struct parallel_pdq_sorter_impl
+        {
+            // Maximum number of threads used to sort a collection,
+            // 0 means that it should match the hardware concurrency
+            std::size_t nb_threads = 0;
+
+            parallel_pdq_sorter_impl() = default;
+
+            constexpr explicit parallel_pdq_sorter_impl(std::size_t nb_threads) noexcept:
+                nb_threads(nb_threads)
+            {}
+
+            template<
+                typename RandomAccessIterator,
+                typename Compare = std::less<>,
+                typename Projection = utility::identity,
+                typename = std::enable_if_t<
+                    is_projection_iterator_v<Projection, RandomAccessIterator, Compare>
+                >
+            >
+            auto operator()(RandomAccessIterator first, RandomAccessIterator last,
+                            Compare compare={}, Projection projection={}) const
+                -> void
+            {
+                static_assert(
+                    std::is_base_of<
+                        std::random_access_iterator_tag,
+                        iterator_category_t<RandomAccessIterator>
+                    >::value,
+                    "parallel_pdq_sorter requires at least random-access iterators"
+                );
+
+                parallel_pdqsort(std::move(first), std::move(last),
+                                 std::move(compare), std::move(projection),
+                                 nb_threads);
+            }
+
+            ////////////////////////////////////////////////////////////
+            // Sorter traits
+
+            using iterator_category = std::random_access_iterator_tag;
+            using is_always_stable = std::false_type;
+        };
+    }
+
+    struct parallel_pdq_sorter:
+        sorter_facade<detail::parallel_pdq_sorter_impl>
+    {
+        parallel_pdq_sorter() = default;
+
+        constexpr explicit parallel_pdq_sorter(std::size_t nb_threads) noexcept:
+            sorter_facade<detail::parallel_pdq_sorter_impl>(nb_threads)
+        {}
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Stable sorter
+
+    template<>
+    struct stable_adapter<parallel_pdq_sorter>:
+        parallel_merge_sorter
+    {
+        stable_adapter() = default;
+
+        constexpr explicit stable_adapter(parallel_pdq_sorter sorter) noexcept:
+            parallel_merge_sorter(sorter.nb_threads)
+        {}
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Sort function
+
+    namespace
+    {
+        constexpr auto&& parallel_pdq_sort
+            = utility::static_const<parallel_pdq_sorter>::value;
+    }
+}
+
+#endif // CPPSORT_SORTERS_PARALLEL_PDQ_SORTER_H_
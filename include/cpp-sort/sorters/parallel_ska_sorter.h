@@ -0,0 +1,114 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef CPPSORT_SORTERS_PARALLEL_SKA_SORTER_H_
+#define CPPSORT_SORTERS_PARALLEL_SKA_SORTER_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <cpp-sort/sorter_facade.h>
+#include <cpp-sort/sorter_traits.h>
+#include <cpp-sort/utility/functional.h>
+#include <cpp-sort/utility/static_const.h>
+#include "../detail/iterator_traits.h"
+#include "../detail/parallel_ska_sort.h"
+#include "../detail/ska_sort.h"
+
+namespace cppsort
+{
+    ////////////////////////////////////////////////////////////
+    // Sorter
+
+    namespace detail
+    {
+        struct parallel_ska_sorter_impl
+        {
+            // Maximum number of threads used to sort a collection,
+            // 0 means that it should match the hardware concurrency
+            std::size_t nb_threads = 0;
+
+            parallel_ska_sorter_impl() = default;
+
+            constexpr explicit parallel_ska_sorter_impl(std::size_t nb_threads) noexcept:
+                nb_threads(nb_threads)
+            {}
+
+            template<
+                typename RandomAccessIterator,
+                typename Projection = utility::identity,
+                typename = std::enable_if_t<
+                    is_projection_iterator_v<Projection, RandomAccessIterator>
+                >
+            >
+            auto operator()(RandomAccessIterator first, RandomAccessIterator last,
+                            Projection projection={}) const
+                -> std::enable_if_t<detail::is_ska_sortable_v<
+                    projected_t<RandomAccessIterator, Projection>
+                >>
+            {
+                static_assert(
+                    std::is_base_of<
+                        std::random_access_iterator_tag,
+                        iterator_category_t<RandomAccessIterator>
+                    >::value,
+                    "parallel_ska_sorter requires at least random-access iterators"
+                );
+
+                parallel_ska_sort(std::move(first), std::move(last),
+                                  std::move(projection), nb_threads);
+            }
+
+            ////////////////////////////////////////////////////////////
+            // Sorter traits
+
+            using iterator_category = std::random_access_iterator_tag;
+            using is_always_stable = std::false_type;
+        };
+    }
+
+    struct parallel_ska_sorter:
+        sorter_facade<detail::parallel_ska_sorter_impl>
+    {
+        parallel_ska_sorter() = default;
+
+        constexpr explicit parallel_ska_sorter(std::size_t nb_threads) noexcept:
+            sorter_facade<detail::parallel_ska_sorter_impl>(nb_threads)
+        {}
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Sort function
+
+    namespace
+    {
+        constexpr auto&& parallel_ska_sort
+            = utility::static_const<parallel_ska_sorter>::value;
+    }
+}
+
+#endif // CPPSORT_SORTERS_PARALLEL_SKA_SORTER_H_
@@ -0,0 +1,229 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef CPPSORT_UTILITY_MEMORY_RESOURCE_H_
+#define CPPSORT_UTILITY_MEMORY_RESOURCE_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+namespace cppsort
+{
+namespace utility
+{
+    ////////////////////////////////////////////////////////////
+    // Memory resource interface
+
+    // Equivalent of std::pmr::memory_resource, which is not
+    // available in C++14; the sorters and adapters allocating
+    // temporary memory get it from the memory resource of the
+    // current thread when there is one
+    class memory_resource
+    {
+        public:
+
+            virtual ~memory_resource() = default;
+
+            auto allocate(std::size_t bytes, std::size_t alignment=alignof(std::max_align_t))
+                -> void*
+            {
+                return do_allocate(bytes, alignment);
+            }
+
+            auto deallocate(void* pointer, std::size_t bytes,
+                            std::size_t alignment=alignof(std::max_align_t))
+                -> void
+            {
+                do_deallocate(pointer, bytes, alignment);
+            }
+
+        private:
+
+            virtual auto do_allocate(std::size_t bytes, std::size_t alignment)
+                -> void* = 0;
+            virtual auto do_deallocate(void* pointer, std::size_t bytes, std::size_t alignment)
+                -> void = 0;
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Memory resource of the current thread
+
+    // Makes the given memory resource the one used by the current
+    // thread until the end of the scope, nullptr meaning that the
+    // memory is allocated with ::operator new
+    class scoped_memory_resource
+    {
+        public:
+
+            explicit scoped_memory_resource(memory_resource* resource) noexcept:
+                previous(current())
+            {
+                current() = resource;
+            }
+
+            scoped_memory_resource(const scoped_memory_resource&) = delete;
+            scoped_memory_resource& operator=(const scoped_memory_resource&) = delete;
+
+            ~scoped_memory_resource()
+            {
+                current() = previous;
+            }
+
+            static auto current() noexcept
+                -> memory_resource*&
+            {
+                thread_local memory_resource* resource = nullptr;
+                return resource;
+            }
+
+        private:
+
+            memory_resource* previous;
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Arena
+
+    // Hands out memory from big blocks and never gives it back
+    // before release() is called; when several blocks were needed,
+    // release() replaces them with a single block big enough for
+    // all of them, so a resource released after every sort ends up
+    // not allocating any memory anymore
+    class monotonic_buffer_resource:
+        public memory_resource
+    {
+        public:
+
+            monotonic_buffer_resource() = default;
+
+            explicit monotonic_buffer_resource(std::size_t initial_size):
+                next_size(initial_size)
+            {}
+
+            monotonic_buffer_resource(const monotonic_buffer_resource&) = delete;
+            monotonic_buffer_resource& operator=(const monotonic_buffer_resource&) = delete;
+
+            ~monotonic_buffer_resource() override
+            {
+                free_blocks();
+            }
+
+            auto release()
+                -> void
+            {
+                if (blocks != nullptr && blocks->next == nullptr) {
+                    // Reuse the only block
+                    used = sizeof(block_header);
+                    return;
+                }
+
+                std::size_t total_size = 0;
+                for (auto block = blocks ; block != nullptr ; block = block->next) {
+                    total_size += block->size;
+                }
+                free_blocks();
+                if (total_size != 0) {
+                    add_block(total_size);
+                }
+            }
+
+            // Total size of the blocks currently owned
+            auto capacity() const noexcept
+                -> std::size_t
+            {
+                std::size_t total_size = 0;
+                for (auto block = blocks ; block != nullptr ; block = block->next) {
+                    total_size += block->size;
+                }
+                return total_size;
+            }
+
+        private:
+
+            struct block_header
+            {
+                block_header* next;
+                std::size_t size;
+            };
+
+            auto do_allocate(std::size_t bytes, std::size_t alignment)
+                -> void* override
+            {
+                if (blocks != nullptr) {
+                    if (auto pointer = try_allocate(bytes, alignment)) {
+                        return pointer;
+                    }
+                }
+                add_block(std::max(next_size, bytes + alignment + sizeof(block_header)));
+                return try_allocate(bytes, alignment);
+            }
+
+            auto do_deallocate(void*, std::size_t, std::size_t)
+                -> void override
+            {}
+
+            auto try_allocate(std::size_t bytes, std::size_t alignment) noexcept
+                -> void*
+            {
+                auto base = reinterpret_cast<std::uintptr_t>(blocks);
+                auto start = (base + used + alignment - 1) / alignment * alignment;
+                if (start + bytes > base + blocks->size) {
+                    return nullptr;
+                }
+                used = start + bytes - base;
+                return reinterpret_cast<void*>(start);
+            }
+
+            auto add_block(std::size_t size)
+                -> void
+            {
+                auto block = static_cast<block_header*>(::operator new(size));
+                block->next = blocks;
+                block->size = size;
+                blocks = block;
+                used = sizeof(block_header);
+                next_size = 2 * size;
+            }
+
+            auto free_blocks() noexcept
+                -> void
+            {
+                while (blocks != nullptr) {
+                    auto next = blocks->next;
+                    ::operator delete(blocks);
+                    blocks = next;
+                }
+            }
+
+            block_header* blocks = nullptr;
+            std::size_t used = 0;
+            std::size_t next_size = 4096;
+    };
+}}
+
+#endif // CPPSORT_UTILITY_MEMORY_RESOURCE_H_
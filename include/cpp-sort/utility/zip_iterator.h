@@ -0,0 +1,108 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef CPPSORT_UTILITY_ZIP_ITERATOR_H_
+#define CPPSORT_UTILITY_ZIP_ITERATOR_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <initializer_list>
+#include <iterator>
+#include <utility>
+#include "../detail/config.h"
+#include "../detail/type_traits.h"
+#include "../detail/zip_iterator.h"
+
+namespace cppsort
+{
+namespace utility
+{
+    ////////////////////////////////////////////////////////////
+    // Structure of arrays
+    //
+    // A zip_iterator walks several parallel sequences at once: any
+    // sorter can sort it, and every operation that moves or swaps
+    // an element is applied to all of the sequences. zip_get<N> is
+    // the projection to use to sort the rows according to the Nth
+    // sequence; the other sequences are only touched when the rows
+    // are moved, so radix sorters such as ska_sorter only ever scan
+    // the key sequence to compute their histograms
+
+    using cppsort::detail::zip_get;
+    using cppsort::detail::zip_iterator;
+    using cppsort::detail::zip_reference;
+    using cppsort::detail::zip_value;
+    using cppsort::detail::make_zip_iterator;
+
+    template<typename... Iterators>
+    class zip_range
+    {
+        public:
+
+            zip_range(zip_iterator<Iterators...> first, zip_iterator<Iterators...> last):
+                first(std::move(first)),
+                last(std::move(last))
+            {}
+
+            auto begin() const
+                -> zip_iterator<Iterators...>
+            {
+                return first;
+            }
+
+            auto end() const
+                -> zip_iterator<Iterators...>
+            {
+                return last;
+            }
+
+        private:
+
+            zip_iterator<Iterators...> first;
+            zip_iterator<Iterators...> last;
+    };
+
+    // The first sequence determines the number of rows, the other
+    // ones have to be at least as long
+    template<typename Iterable, typename... Iterables>
+    auto zip(Iterable& iterable, Iterables&... iterables)
+        -> zip_range<
+            cppsort::detail::remove_cvref_t<decltype(std::begin(iterable))>,
+            cppsort::detail::remove_cvref_t<decltype(std::begin(iterables))>...
+        >
+    {
+        auto size = std::distance(std::begin(iterable), std::end(iterable));
+#ifdef CPPSORT_ENABLE_ASSERTIONS
+        (void) std::initializer_list<int>{
+            (CPPSORT_ASSERT(std::distance(std::begin(iterables), std::end(iterables)) >= size), 0)...
+        };
+#endif
+        return {
+            make_zip_iterator(std::begin(iterable), std::begin(iterables)...),
+            make_zip_iterator(std::end(iterable), std::next(std::begin(iterables), size)...)
+        };
+    }
+}}
+
+#endif // CPPSORT_UTILITY_ZIP_ITERATOR_H_
@@ -0,0 +1,132 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <list>
+#include <vector>
+#include <catch2/catch.hpp>
+#include <cpp-sort/adapters/buffered_adapter.h>
+#include <cpp-sort/adapters/schwartz_adapter.h>
+#include <cpp-sort/sort.h>
+#include <cpp-sort/sorter_facade.h>
+#include <cpp-sort/sorters/merge_sorter.h>
+#include <cpp-sort/sorters/pdq_sorter.h>
+#include <cpp-sort/sorters/spin_sorter.h>
+#include <cpp-sort/sorters/tim_sorter.h>
+#include <cpp-sort/utility/memory_resource.h>
+#include "../distributions.h"
+
+namespace
+{
+    // Memory resource seen by the last call to spy_sorter
+    cppsort::utility::memory_resource* last_resource = nullptr;
+
+    struct spy_sorter_impl
+    {
+        template<typename Iterator>
+        auto operator()(Iterator first, Iterator last) const
+            -> void
+        {
+            last_resource = cppsort::utility::scoped_memory_resource::current();
+            cppsort::merge_sort(first, last);
+        }
+    };
+
+    struct spy_sorter:
+        cppsort::sorter_facade<spy_sorter_impl>
+    {};
+}
+
+TEST_CASE( "buffered_adapter tests", "[buffered_adapter]" )
+{
+    std::vector<int> collection;
+    collection.reserve(10'000);
+    auto distribution = dist::shuffled{};
+    distribution(std::back_inserter(collection), 10'000);
+
+    SECTION( "buffered sorters" )
+    {
+        auto merge = cppsort::buffered_adapter<cppsort::merge_sorter>{};
+        auto tim = cppsort::buffered_adapter<cppsort::tim_sorter>{};
+        auto spin = cppsort::buffered_adapter<cppsort::spin_sorter>(cppsort::spin_sorter{}, 65536);
+        auto schwartz = cppsort::buffered_adapter<
+            cppsort::schwartz_adapter<cppsort::pdq_sorter>
+        >{};
+
+        for (int idx = 0 ; idx < 3 ; ++idx) {
+            auto copy = collection;
+            cppsort::sort(merge, copy);
+            CHECK( std::is_sorted(copy.begin(), copy.end()) );
+
+            copy = collection;
+            cppsort::sort(tim, copy, std::greater<>{});
+            CHECK( std::is_sorted(copy.begin(), copy.end(), std::greater<>{}) );
+
+            copy = collection;
+            cppsort::sort(spin, copy.begin(), copy.end());
+            CHECK( std::is_sorted(copy.begin(), copy.end()) );
+
+            copy = collection;
+            cppsort::sort(schwartz, copy, std::negate<>{});
+            CHECK( std::is_sorted(copy.begin(), copy.end(), std::greater<>{}) );
+        }
+
+        std::list<int> li(collection.begin(), collection.end());
+        cppsort::sort(merge, li);
+        CHECK( std::is_sorted(li.begin(), li.end()) );
+    }
+
+    SECTION( "the arena is kept across calls" )
+    {
+        cppsort::utility::monotonic_buffer_resource outer;
+        cppsort::utility::scoped_memory_resource _(&outer);
+
+        cppsort::buffered_adapter<spy_sorter> sorter;
+        auto copy = collection;
+        sorter(copy);
+        auto arena = last_resource;
+        CHECK( arena != nullptr );
+        CHECK( arena != &outer );
+        CHECK( std::is_sorted(copy.begin(), copy.end()) );
+
+        copy = collection;
+        sorter(copy);
+        CHECK( last_resource == arena );
+        CHECK( cppsort::utility::scoped_memory_resource::current() == &outer );
+
+        // Copies get their own arena
+        auto sorter_copy = sorter;
+        copy = collection;
+        sorter_copy(copy);
+        CHECK( last_resource != arena );
+        CHECK( std::is_sorted(copy.begin(), copy.end()) );
+    }
+
+    SECTION( "stability" )
+    {
+        CHECK( cppsort::is_always_stable_v<cppsort::buffered_adapter<cppsort::merge_sorter>> );
+        CHECK( not cppsort::is_always_stable_v<cppsort::buffered_adapter<cppsort::pdq_sorter>> );
+    }
+}
@@ -25,12 +25,18 @@
 #include <forward_list>
 #include <functional>
 #include <iterator>
+#include <numeric>
+#include <stdexcept>
+#include <string>
 #include <vector>
 #include <catch2/catch.hpp>
 #include <cpp-sort/adapters/container_aware_adapter.h>
 #include <cpp-sort/sort.h>
 #include <cpp-sort/sorters/insertion_sorter.h>
 #include <cpp-sort/sorters/merge_sorter.h>
+#include <cpp-sort/sorters/parallel_merge_sorter.h>
+#include <cpp-sort/sorters/parallel_pdq_sorter.h>
+#include <cpp-sort/sorters/pdq_sorter.h>
 #include <cpp-sort/sorters/selection_sorter.h>
 #include "../distributions.h"
 
@@ -157,4 +163,125 @@ TEST_CASE( "container_aware_adapter and std::forward_list",
         cppsort::sort(sorter{}, vec_copy);
         CHECK( std::is_sorted(std::begin(vec_copy), std::end(vec_copy)) );
     }
+
+    SECTION( "pdq_sorter" )
+    {
+        using sorter = cppsort::container_aware_adapter<
+            cppsort::pdq_sorter
+        >;
+        std::forward_list<double> collection(std::begin(vec), std::end(vec));
+
+        collection = { std::begin(vec), std::end(vec) };
+        sorter{}(collection);
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection)) );
+
+        collection = { std::begin(vec), std::end(vec) };
+        sorter{}(collection, std::greater<>{});
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection), std::greater<>{}) );
+
+        collection = { std::begin(vec), std::end(vec) };
+        cppsort::sort(sorter{}, collection, std::greater<>{});
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection), std::greater<>{}) );
+
+        collection = { std::begin(vec), std::end(vec) };
+        sorter{}(collection, std::negate<>{});
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection), std::greater<>{}) );
+
+        collection = { std::begin(vec), std::end(vec) };
+        cppsort::sort(sorter{}, collection, std::negate<>{});
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection), std::greater<>{}) );
+
+        collection = { std::begin(vec), std::end(vec) };
+        sorter{}(collection, std::greater<>{}, std::negate<>{});
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection)) );
+
+        collection = { std::begin(vec), std::end(vec) };
+        cppsort::sort(sorter{}, collection, std::greater<>{}, std::negate<>{});
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection)) );
+
+        // Make sure that the generic overload is also called when needed
+
+        auto vec_copy = vec;
+        cppsort::sort(sorter{}, vec_copy);
+        CHECK( std::is_sorted(std::begin(vec_copy), std::end(vec_copy)) );
+    }
+}
+
+namespace
+{
+    struct record
+    {
+        int key;
+        int order;
+        std::string payload;
+    };
+}
+
+TEST_CASE( "container_aware_adapter, std::forward_list and random-access sorters",
+           "[container_aware_adapter]" )
+{
+    // Sorters that need random-access iterators sort handles
+    // to the nodes, then the nodes are relinked in order
+
+    std::vector<int> keys; keys.reserve(5000);
+    auto distribution = dist::shuffled{};
+    distribution(std::back_inserter(keys), 5000, 0);
+
+    std::forward_list<record> collection;
+    for (int i = static_cast<int>(keys.size()) - 1 ; i >= 0 ; --i) {
+        collection.push_front({ keys[i] % 100, i, std::to_string(keys[i]) });
+    }
+
+    SECTION( "stable sorter with a projection" )
+    {
+        using sorter = cppsort::container_aware_adapter<
+            cppsort::parallel_merge_sorter
+        >;
+        CHECK( cppsort::is_stable<sorter(std::forward_list<record>&, decltype(&record::key))>::value );
+
+        sorter{}(collection, &record::key);
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection),
+                              [](const record& lhs, const record& rhs) {
+                                  if (lhs.key != rhs.key) return lhs.key < rhs.key;
+                                  return lhs.order < rhs.order;
+                              }) );
+    }
+
+    SECTION( "non-trivial keys" )
+    {
+        using sorter = cppsort::container_aware_adapter<
+            cppsort::parallel_pdq_sorter
+        >;
+        sorter{}(collection, std::greater<>{}, &record::payload);
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection),
+                              [](const record& lhs, const record& rhs) {
+                                  return lhs.payload > rhs.payload;
+                              }) );
+        CHECK( std::distance(std::begin(collection), std::end(collection)) == 5000 );
+    }
+
+    SECTION( "exception thrown by the comparison" )
+    {
+        using sorter = cppsort::container_aware_adapter<
+            cppsort::pdq_sorter
+        >;
+        int count = 0;
+        auto compare = [&count](int lhs, int rhs) {
+            if (++count == 10000) {
+                throw std::runtime_error("comparison failed");
+            }
+            return lhs < rhs;
+        };
+        CHECK_THROWS_AS( sorter{}(collection, compare, &record::key), std::runtime_error );
+
+        // No node is lost
+        std::vector<int> orders;
+        for (auto& elem: collection) {
+            orders.push_back(elem.order);
+        }
+        std::sort(orders.begin(), orders.end());
+        std::vector<int> expected(5000);
+        std::iota(expected.begin(), expected.end(), 0);
+        CHECK( orders == expected );
+    }
 }
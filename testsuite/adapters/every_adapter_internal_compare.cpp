@@ -43,6 +43,16 @@ TEST_CASE( "test most adapters with a pointer to member function comparison",
     auto distribution = dist::shuffled{};
     distribution(std::back_inserter(collection), 65, 0);
 
+    SECTION( "buffered_adapter" )
+    {
+        using sorter = cppsort::buffered_adapter<
+            cppsort::merge_sorter
+        >;
+
+        sorter{}(collection, &internal_compare<int>::compare_to);
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection)) );
+    }
+
     SECTION( "counting_adapter" )
     {
         using sorter = cppsort::counting_adapter<
@@ -58,6 +58,16 @@ TEST_CASE( "test adapters extended compatibility with LWG 3031", "[adapters]" )
 
     auto non_const_compare = [](int& lhs, int& rhs) { return lhs < rhs; };
 
+    SECTION( "buffered_adapter" )
+    {
+        using sorter = cppsort::buffered_adapter<
+            cppsort::merge_sorter
+        >;
+
+        sorter{}(vec, non_const_compare);
+        CHECK( std::is_sorted(std::begin(vec), std::end(vec)) );
+    }
+
     SECTION( "counting_adapter" )
     {
         using sorter = cppsort::counting_adapter<
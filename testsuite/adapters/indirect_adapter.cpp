@@ -23,12 +23,17 @@
  */
 #include <algorithm>
 #include <functional>
+#include <array>
+#include <cstdint>
 #include <iterator>
+#include <string>
 #include <vector>
 #include <catch2/catch.hpp>
 #include <cpp-sort/adapters/indirect_adapter.h>
 #include <cpp-sort/sort.h>
+#include <cpp-sort/sorters/merge_sorter.h>
 #include <cpp-sort/sorters/quick_sorter.h>
+#include <cpp-sort/sorters/ska_sorter.h>
 #include "../algorithm.h"
 #include "../distributions.h"
 #include "../span.h"
@@ -111,3 +116,87 @@ TEST_CASE( "indirect_adapter with temporary span",
         CHECK( std::is_sorted(std::begin(collection), std::end(collection)) );
     }
 }
+
+namespace
+{
+    struct big_record
+    {
+        std::uint64_t key;
+        int order;
+        std::array<char, 188> payload;
+    };
+}
+
+TEST_CASE( "indirect_adapter with big records and small keys",
+           "[indirect_adapter]" )
+{
+    // Sorting by a small trivially copyable key uses the compact
+    // key/index mode, these tests make sure that it behaves like
+    // the iterator mode
+
+    std::vector<big_record> vec; vec.reserve(1000);
+    auto distribution = dist::shuffled{};
+    std::vector<int> keys; keys.reserve(1000);
+    distribution(std::back_inserter(keys), 1000, 0);
+    for (int i = 0 ; i < 1000 ; ++i) {
+        big_record record;
+        record.key = static_cast<std::uint64_t>(keys[i] % 50);
+        record.order = i;
+        record.payload.fill(static_cast<char>(keys[i] % 50));
+        vec.push_back(record);
+    }
+
+    auto check_records = [](const std::vector<big_record>& records) {
+        for (const auto& record: records) {
+            if (std::any_of(std::begin(record.payload), std::end(record.payload),
+                            [&](char c) { return c != static_cast<char>(record.key); })) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    SECTION( "stable sorter" )
+    {
+        using sorter = cppsort::indirect_adapter<
+            cppsort::merge_sorter
+        >;
+        cppsort::sort(sorter{}, vec, &big_record::key);
+        CHECK( std::is_sorted(std::begin(vec), std::end(vec),
+                              [](const big_record& lhs, const big_record& rhs) {
+                                  if (lhs.key < rhs.key) return true;
+                                  if (rhs.key < lhs.key) return false;
+                                  return lhs.order < rhs.order;
+                              }) );
+        CHECK( check_records(vec) );
+    }
+
+    SECTION( "radix sorter" )
+    {
+        using sorter = cppsort::indirect_adapter<
+            cppsort::ska_sorter
+        >;
+        cppsort::sort(sorter{}, vec, &big_record::key);
+        CHECK( helpers::is_sorted(std::begin(vec), std::end(vec),
+                                  std::less<>{}, &big_record::key) );
+        CHECK( check_records(vec) );
+    }
+}
+
+TEST_CASE( "indirect_adapter with non-trivial keys",
+           "[indirect_adapter]" )
+{
+    std::vector<std::string> vec; vec.reserve(221);
+    auto distribution = dist::shuffled{};
+    std::vector<int> keys; keys.reserve(221);
+    distribution(std::back_inserter(keys), 221, -32);
+    for (int key: keys) {
+        vec.push_back(std::to_string(key));
+    }
+
+    using sorter = cppsort::indirect_adapter<
+        cppsort::quick_sorter
+    >;
+    cppsort::sort(sorter{}, vec, std::greater<>{});
+    CHECK( std::is_sorted(std::begin(vec), std::end(vec), std::greater<>{}) );
+}
@@ -52,6 +52,10 @@ TEMPLATE_TEST_CASE( "every sorter with Schwartzian transform adapter", "[schwart
                     cppsort::insertion_sorter,
                     cppsort::merge_insertion_sorter,
                     cppsort::merge_sorter,
+                    cppsort::parallel_merge_sorter,
+                    cppsort::parallel_pdq_sorter,
+                    cppsort::parallel_tim_sorter,
+                    cppsort::parallel_verge_sorter,
                     cppsort::pdq_sorter,
                     cppsort::poplar_sorter,
                     cppsort::quick_merge_sorter,
@@ -127,3 +131,51 @@ TEST_CASE( "type-specific sorters with Schwartzian transform adapter", "[schwart
                                   std::greater<>{}, &wrapper<std::string>::value) );
     }
 }
+
+TEST_CASE( "radix sorters with Schwartzian transform adapter and records", "[schwartz_adapter]" )
+{
+    // Radix sorters sort the projected keys and the positions of
+    // the records separately, make sure that every record follows
+    // its key and that the projection is computed only once
+
+    struct record
+    {
+        std::string name;
+        int id;
+    };
+
+    std::vector<record> collection;
+    for (int i = 0 ; i < 412 ; ++i) {
+        collection.push_back({ std::to_string(i % 100), i });
+    }
+    std::mt19937 engine(Catch::rngSeed());
+    std::shuffle(std::begin(collection), std::end(collection), engine);
+
+    int nb_projections = 0;
+    auto projection = [&nb_projections](const record& rec) {
+        ++nb_projections;
+        return std::stoi(rec.name) * 1000 + rec.id;
+    };
+
+    SECTION( "ska_sorter" )
+    {
+        using sorter = cppsort::schwartz_adapter<cppsort::ska_sorter>;
+        cppsort::sort(sorter{}, collection, projection);
+        CHECK( nb_projections == 412 );
+    }
+
+    SECTION( "spread_sorter" )
+    {
+        using sorter = cppsort::schwartz_adapter<cppsort::spread_sorter>;
+        cppsort::sort(sorter{}, collection, projection);
+        CHECK( nb_projections == 412 );
+    }
+
+    CHECK( std::is_sorted(std::begin(collection), std::end(collection),
+                          [](const record& lhs, const record& rhs) {
+                              return std::stoi(lhs.name) * 1000 + lhs.id
+                                   < std::stoi(rhs.name) * 1000 + rhs.id;
+                          }) );
+    CHECK( std::all_of(std::begin(collection), std::end(collection),
+                       [](const record& rec) { return std::stoi(rec.name) == rec.id % 100; }) );
+}
@@ -53,6 +53,10 @@ TEMPLATE_TEST_CASE( "every sorter with Schwartzian transform adapter and reverse
                     cppsort::insertion_sorter,
                     cppsort::merge_insertion_sorter,
                     cppsort::merge_sorter,
+                    cppsort::parallel_merge_sorter,
+                    cppsort::parallel_pdq_sorter,
+                    cppsort::parallel_tim_sorter,
+                    cppsort::parallel_verge_sorter,
                     cppsort::pdq_sorter,
                     cppsort::poplar_sorter,
                     cppsort::quick_merge_sorter,
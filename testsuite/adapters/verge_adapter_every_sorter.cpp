@@ -38,8 +38,13 @@ TEMPLATE_TEST_CASE( "every sorter with verge_adapter", "[verge_adapter]",
                     cppsort::grail_sorter<>,
                     cppsort::heap_sorter,
                     cppsort::insertion_sorter,
+                    cppsort::lsd_radix_sorter<>,
                     cppsort::merge_insertion_sorter,
                     cppsort::merge_sorter,
+                    cppsort::parallel_merge_sorter,
+                    cppsort::parallel_pdq_sorter,
+                    cppsort::parallel_ska_sorter,
+                    cppsort::parallel_tim_sorter,
                     cppsort::pdq_sorter,
                     cppsort::poplar_sorter,
                     cppsort::quick_merge_sorter,
@@ -42,7 +42,13 @@ TEMPLATE_TEST_CASE( "test random-access sorters with all_equal distribution", "[
                         cppsort::utility::dynamic_buffer<cppsort::utility::sqrt>
                     >,
                     cppsort::heap_sorter,
+                    cppsort::lsd_radix_sorter<>,
                     cppsort::merge_sorter,
+                    cppsort::parallel_merge_sorter,
+                    cppsort::parallel_pdq_sorter,
+                    cppsort::parallel_ska_sorter,
+                    cppsort::parallel_tim_sorter,
+                    cppsort::parallel_verge_sorter,
                     cppsort::pdq_sorter,
                     cppsort::poplar_sorter,
                     cppsort::quick_merge_sorter,
@@ -65,6 +65,12 @@ TEST_CASE( "test every instantiated sorter", "[sorters]" )
         CHECK( std::is_sorted(std::begin(collection), std::end(collection)) );
     }
 
+    SECTION( "external_sort" )
+    {
+        cppsort::external_sort(collection);
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection)) );
+    }
+
     SECTION( "grail_sorter" )
     {
         cppsort::grail_sort(collection);
@@ -83,6 +89,12 @@ TEST_CASE( "test every instantiated sorter", "[sorters]" )
         CHECK( std::is_sorted(std::begin(collection), std::end(collection)) );
     }
 
+    SECTION( "lsd_radix_sorter" )
+    {
+        cppsort::lsd_radix_sort(collection);
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection)) );
+    }
+
     SECTION( "merge_insertion_sorter" )
     {
         cppsort::merge_insertion_sort(collection);
@@ -95,6 +107,36 @@ TEST_CASE( "test every instantiated sorter", "[sorters]" )
         CHECK( std::is_sorted(std::begin(collection), std::end(collection)) );
     }
 
+    SECTION( "parallel_merge_sorter" )
+    {
+        cppsort::parallel_merge_sort(collection);
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection)) );
+    }
+
+    SECTION( "parallel_pdq_sorter" )
+    {
+        cppsort::parallel_pdq_sort(collection);
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection)) );
+    }
+
+    SECTION( "parallel_ska_sorter" )
+    {
+        cppsort::parallel_ska_sort(collection);
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection)) );
+    }
+
+    SECTION( "parallel_tim_sorter" )
+    {
+        cppsort::parallel_tim_sort(collection);
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection)) );
+    }
+
+    SECTION( "parallel_verge_sorter" )
+    {
+        cppsort::parallel_verge_sort(collection);
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection)) );
+    }
+
     SECTION( "pdq_sorter" )
     {
         cppsort::pdq_sort(collection);
@@ -35,20 +35,28 @@
 #include "distributions.h"
 
 TEMPLATE_TEST_CASE( "test every random-access sorter with vector", "[sorters]",
+                    cppsort::auto_sorter<>,
                     cppsort::block_sorter<>,
                     cppsort::block_sorter<
                         cppsort::utility::dynamic_buffer<cppsort::utility::half>
                     >,
                     cppsort::counting_sorter,
                     cppsort::drop_merge_sorter,
+                    cppsort::external_sorter<>,
                     cppsort::grail_sorter<>,
                     cppsort::grail_sorter<
                         cppsort::utility::dynamic_buffer<cppsort::utility::sqrt>
                     >,
                     cppsort::heap_sorter,
                     cppsort::insertion_sorter,
+                    cppsort::lsd_radix_sorter<>,
                     cppsort::merge_insertion_sorter,
                     cppsort::merge_sorter,
+                    cppsort::parallel_merge_sorter,
+                    cppsort::parallel_pdq_sorter,
+                    cppsort::parallel_ska_sorter,
+                    cppsort::parallel_tim_sorter,
+                    cppsort::parallel_verge_sorter,
                     cppsort::pdq_sorter,
                     cppsort::poplar_sorter,
                     cppsort::quick_merge_sorter,
@@ -83,14 +91,21 @@ TEMPLATE_TEST_CASE( "test every random-access sorter with deque", "[sorters]",
                     >,
                     cppsort::counting_sorter,
                     cppsort::drop_merge_sorter,
+                    cppsort::external_sorter<>,
                     cppsort::grail_sorter<>,
                     cppsort::grail_sorter<
                         cppsort::utility::dynamic_buffer<cppsort::utility::sqrt>
                     >,
                     cppsort::heap_sorter,
                     cppsort::insertion_sorter,
+                    cppsort::lsd_radix_sorter<>,
                     cppsort::merge_insertion_sorter,
                     cppsort::merge_sorter,
+                    cppsort::parallel_merge_sorter,
+                    cppsort::parallel_pdq_sorter,
+                    cppsort::parallel_ska_sorter,
+                    cppsort::parallel_tim_sorter,
+                    cppsort::parallel_verge_sorter,
                     cppsort::pdq_sorter,
                     cppsort::poplar_sorter,
                     cppsort::quick_merge_sorter,
@@ -101,3 +101,19 @@ TEMPLATE_TEST_CASE( "test heap exhaustion for forward sorters", "[sorters][heap_
     }
     CHECK( std::is_sorted(std::begin(collection), std::end(collection)) );
 }
+
+TEST_CASE( "test heap exhaustion for parallel_merge_sorter", "[sorters][heap_exhaustion]" )
+{
+    // Scheduling the tasks still requires a few small allocations,
+    // only the big merge buffers fail to be allocated; the other
+    // threads of the pool are not affected by memory exhaustion
+    std::vector<int> collection; collection.reserve(50000);
+    auto distribution = dist::shuffled{};
+    distribution(std::back_inserter(collection), 50000, -125);
+
+    {
+        scoped_memory_exhaustion _(4096);
+        cppsort::parallel_merge_sorter(4)(collection);
+    }
+    CHECK( std::is_sorted(std::begin(collection), std::end(collection)) );
+}
@@ -0,0 +1,162 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <string>
+#include <vector>
+#include <catch2/catch.hpp>
+#include <cpp-sort/incremental_sorter.h>
+#include <cpp-sort/sorters/insertion_sorter.h>
+#include <cpp-sort/sorters/merge_sorter.h>
+#include <cpp-sort/sorters/pdq_sorter.h>
+#include "distributions.h"
+
+namespace
+{
+    struct wrapper
+    {
+        int value;
+        std::size_t order;
+    };
+}
+
+TEST_CASE( "incremental_sorter tests", "[incremental_sorter]" )
+{
+    std::vector<int> collection;
+    collection.reserve(50'000);
+    auto distribution = dist::shuffled{};
+    distribution(std::back_inserter(collection), 50'000);
+
+    auto expected = collection;
+    std::sort(std::begin(expected), std::end(expected));
+
+    SECTION( "chunks of the same size" )
+    {
+        cppsort::incremental_sorter<int> sorter;
+        for (std::size_t idx = 0 ; idx < collection.size() ; idx += 1000) {
+            sorter.push(collection.begin() + idx, collection.begin() + idx + 1000);
+            // The merge policy keeps the stack of runs small
+            CHECK( sorter.pending_runs() <= 16 );
+        }
+        sorter.finish();
+        CHECK( sorter.pending_runs() == 1 );
+        CHECK( std::equal(sorter.begin(), sorter.end(), expected.begin(), expected.end()) );
+    }
+
+    SECTION( "chunks of different sizes" )
+    {
+        cppsort::incremental_sorter<int, cppsort::pdq_sorter> sorter;
+        std::size_t idx = 0;
+        for (std::size_t size = 1 ; idx < collection.size() ; size = size * 3 % 1999) {
+            auto last = std::min(idx + size, collection.size());
+            sorter.push(std::vector<int>(collection.begin() + idx, collection.begin() + last));
+            idx = last;
+        }
+        sorter.push(std::vector<int>{});
+        sorter.finish();
+        CHECK( sorter.size() == expected.size() );
+        CHECK( std::equal(sorter.begin(), sorter.end(), expected.begin(), expected.end()) );
+    }
+
+    SECTION( "push after finish" )
+    {
+        cppsort::incremental_sorter<int, cppsort::insertion_sorter> sorter;
+        sorter.push(collection.begin(), collection.begin() + 100);
+        sorter.finish();
+        CHECK( std::is_sorted(sorter.begin(), sorter.end()) );
+        sorter.push(collection.begin() + 100, collection.begin() + 250);
+        sorter.finish();
+
+        auto result = sorter.release();
+        CHECK( sorter.empty() );
+        CHECK( result.size() == 250 );
+        CHECK( std::is_sorted(result.begin(), result.end()) );
+    }
+
+    SECTION( "ascending chunks are stitched" )
+    {
+        cppsort::incremental_sorter<int> sorter;
+        for (std::size_t idx = 0 ; idx < expected.size() ; idx += 500) {
+            sorter.push(expected.begin() + idx, expected.begin() + idx + 500);
+            CHECK( sorter.pending_runs() == 1 );
+        }
+        sorter.finish();
+        CHECK( std::equal(sorter.begin(), sorter.end(), expected.begin(), expected.end()) );
+    }
+
+    SECTION( "comparison and projection" )
+    {
+        std::vector<std::string> strings;
+        for (int value: collection) {
+            strings.push_back(std::to_string(value));
+        }
+
+        cppsort::incremental_sorter<
+            std::string, cppsort::pdq_sorter, std::greater<>, std::size_t (std::string::*)() const
+        > sorter(cppsort::pdq_sorter{}, std::greater<>{}, &std::string::size);
+        for (std::size_t idx = 0 ; idx < strings.size() ; idx += 777) {
+            auto last = std::min(idx + 777, strings.size());
+            sorter.push(strings.begin() + idx, strings.begin() + last);
+        }
+        sorter.finish();
+        CHECK( sorter.size() == strings.size() );
+        CHECK( std::is_sorted(sorter.begin(), sorter.end(), [](const auto& lhs, const auto& rhs) {
+            return lhs.size() > rhs.size();
+        }) );
+    }
+}
+
+TEST_CASE( "incremental_sorter stability", "[incremental_sorter][is_stable]" )
+{
+    // With a stable sorter, equivalent elements keep the
+    // order in which they were pushed
+
+    std::vector<int> values;
+    values.reserve(20'000);
+    auto distribution = dist::shuffled_16_values{};
+    distribution(std::back_inserter(values), 20'000);
+
+    std::vector<wrapper> collection;
+    for (std::size_t idx = 0 ; idx < values.size() ; ++idx) {
+        collection.push_back({values[idx], idx});
+    }
+
+    cppsort::incremental_sorter<
+        wrapper, cppsort::merge_sorter, std::less<>, int wrapper::*
+    > sorter(cppsort::merge_sorter{}, std::less<>{}, &wrapper::value);
+    for (std::size_t idx = 0 ; idx < collection.size() ; idx += 300) {
+        auto last = std::min(idx + 300, collection.size());
+        sorter.push(collection.begin() + idx, collection.begin() + last);
+    }
+    sorter.finish();
+
+    CHECK( std::is_sorted(sorter.begin(), sorter.end(), [](const auto& lhs, const auto& rhs) {
+        if (lhs.value != rhs.value) {
+            return lhs.value < rhs.value;
+        }
+        return lhs.order < rhs.order;
+    }) );
+}
@@ -0,0 +1,135 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <algorithm>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <random>
+#include <vector>
+#include <catch2/catch.hpp>
+#include <cpp-sort/kway_merge.h>
+
+namespace
+{
+    struct wrapper
+    {
+        int value;
+        std::size_t range;
+    };
+}
+
+TEST_CASE( "kway_merge tests", "[kway_merge]" )
+{
+    // Pseudo-random number engine
+    std::mt19937 engine(Catch::rngSeed());
+
+    SECTION( "merge any number of ranges" )
+    {
+        // Odd numbers of ranges give trees with leaves
+        // at different depths
+        auto nb_ranges = GENERATE(as<std::size_t>{}, 0, 1, 2, 3, 7, 8, 33);
+
+        std::uniform_int_distribution<int> size_distribution(0, 300);
+        std::uniform_int_distribution<int> value_distribution(-500, 500);
+        std::vector<std::vector<int>> ranges(nb_ranges);
+        std::vector<int> expected;
+        for (auto& range: ranges) {
+            range.resize(size_distribution(engine));
+            for (auto& value: range) {
+                value = value_distribution(engine);
+            }
+            std::sort(std::begin(range), std::end(range));
+            expected.insert(std::end(expected), std::begin(range), std::end(range));
+        }
+        std::sort(std::begin(expected), std::end(expected));
+
+        std::vector<int> result;
+        cppsort::kway_merge(ranges, std::back_inserter(result));
+        CHECK( result == expected );
+    }
+
+    SECTION( "merge with compare into an output range" )
+    {
+        std::list<std::deque<int>> ranges = {
+            { 9, 5, 1 },
+            {},
+            { 8, 7, 6, 0 },
+            { 4, 3, 2 }
+        };
+        std::vector<int> result(10);
+        auto end = cppsort::kway_merge(ranges, std::begin(result), std::greater<>{});
+        CHECK( end == std::end(result) );
+        CHECK( std::is_sorted(std::begin(result), std::end(result), std::greater<>{}) );
+    }
+
+    SECTION( "stability with projection" )
+    {
+        std::vector<std::vector<wrapper>> ranges(5);
+        for (std::size_t idx = 0 ; idx < ranges.size() ; ++idx) {
+            for (int value = 0 ; value < 20 ; ++value) {
+                ranges[idx].push_back({ value / 4, idx });
+            }
+        }
+
+        std::vector<wrapper> result;
+        cppsort::kway_merge(ranges, std::back_inserter(result), std::less<>{}, &wrapper::value);
+        CHECK( std::is_sorted(std::begin(result), std::end(result),
+                              [](const wrapper& lhs, const wrapper& rhs) {
+                                  return lhs.value < rhs.value
+                                      || (lhs.value == rhs.value && lhs.range < rhs.range);
+                              }) );
+    }
+
+    SECTION( "move-only types" )
+    {
+        std::vector<std::vector<std::unique_ptr<int>>> ranges(3);
+        for (int value = 0 ; value < 30 ; ++value) {
+            ranges[value % 3].push_back(std::make_unique<int>(value));
+        }
+
+        std::vector<std::unique_ptr<int>> result;
+        cppsort::kway_merge(ranges, std::back_inserter(result), std::less<>{},
+                            [](const std::unique_ptr<int>& ptr) { return *ptr; });
+        REQUIRE( result.size() == 30 );
+        for (int value = 0 ; value < 30 ; ++value) {
+            CHECK( *result[value] == value );
+        }
+    }
+
+    SECTION( "const ranges are copied" )
+    {
+        const std::vector<std::vector<int>> ranges = {
+            { 0, 3, 6 },
+            { 1, 4, 7 },
+            { 2, 5, 8 }
+        };
+        std::vector<int> result;
+        cppsort::kway_merge(ranges, std::back_inserter(result));
+        CHECK( result == std::vector<int>({ 0, 1, 2, 3, 4, 5, 6, 7, 8 }) );
+        CHECK( ranges[0] == std::vector<int>({ 0, 3, 6 }) );
+    }
+}
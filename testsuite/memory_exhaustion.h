@@ -27,9 +27,11 @@
 ////////////////////////////////////////////////////////////
 // Headers
 ////////////////////////////////////////////////////////////
+#include <cstddef>
 
-// This variable is defined in new_delete.h
+// These variables are defined in new_delete.h
 extern thread_local bool heap_memory_exhaustion_should_fail;
+extern thread_local std::size_t heap_memory_exhaustion_min_size;
 
 // Class to make memory exhaustion fail in the current scope
 struct scoped_memory_exhaustion
@@ -39,9 +41,17 @@ struct scoped_memory_exhaustion
         heap_memory_exhaustion_should_fail = true;
     }
 
+    // Only allocations of at least min_size bytes fail
+    explicit scoped_memory_exhaustion(std::size_t min_size) noexcept
+    {
+        heap_memory_exhaustion_should_fail = true;
+        heap_memory_exhaustion_min_size = min_size;
+    }
+
     ~scoped_memory_exhaustion()
     {
         heap_memory_exhaustion_should_fail = false;
+        heap_memory_exhaustion_min_size = 0;
     }
 };
 
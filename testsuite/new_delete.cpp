@@ -32,13 +32,25 @@
 // extra memory
 //
 
-// This variable controls whether memory exhaustion should fail
+// These variables control whether memory exhaustion should fail
+// and which allocation sizes are affected
 thread_local bool heap_memory_exhaustion_should_fail = false;
+thread_local std::size_t heap_memory_exhaustion_min_size = 0;
+
+namespace
+{
+    auto allocation_should_fail(std::size_t size) noexcept
+        -> bool
+    {
+        return heap_memory_exhaustion_should_fail
+            && size >= heap_memory_exhaustion_min_size;
+    }
+}
 
 auto operator new(std::size_t size)
     -> void*
 {
-    if (heap_memory_exhaustion_should_fail) {
+    if (allocation_should_fail(size)) {
         throw std::bad_alloc();
     }
 
@@ -61,7 +73,7 @@ auto operator new(std::size_t size)
 auto operator new(std::size_t size, const std::nothrow_t&) noexcept
     -> void*
 {
-    if (heap_memory_exhaustion_should_fail) {
+    if (allocation_should_fail(size)) {
         return nullptr;
     }
 
@@ -82,7 +94,7 @@ auto operator new[](std::size_t size)
 auto operator new[](std::size_t size, const std::nothrow_t&) noexcept
     -> void*
 {
-    if (heap_memory_exhaustion_should_fail) {
+    if (allocation_should_fail(size)) {
         return nullptr;
     }
 
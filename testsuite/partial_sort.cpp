@@ -0,0 +1,111 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <algorithm>
+#include <forward_list>
+#include <functional>
+#include <iterator>
+#include <sstream>
+#include <vector>
+#include <catch2/catch.hpp>
+#include <cpp-sort/partial_sort.h>
+#include <cpp-sort/sorters/merge_sorter.h>
+#include <cpp-sort/sorters/pdq_sorter.h>
+#include "distributions.h"
+
+TEST_CASE( "partial sort and selection", "[partial_sort]" )
+{
+    std::vector<int> collection;
+    collection.reserve(10'000);
+    auto distribution = dist::shuffled{};
+    distribution(std::back_inserter(collection), 10'000);
+
+    auto expected = collection;
+    std::sort(std::begin(expected), std::end(expected));
+
+    SECTION( "nth_element" )
+    {
+        auto nth = cppsort::nth_element(collection, 4321);
+        CHECK( *nth == expected[4321] );
+        CHECK( std::all_of(collection.begin(), nth, [&](int value) { return value <= *nth; }) );
+        CHECK( std::all_of(nth, collection.end(), [&](int value) { return value >= *nth; }) );
+        CHECK( cppsort::nth_element(collection, 10'000) == collection.end() );
+    }
+
+    SECTION( "partial_sort" )
+    {
+        auto k = GENERATE(as<std::size_t>{}, 0, 1, 100, 5000, 10'000, 20'000);
+        auto sorted_last = cppsort::partial_sort(cppsort::pdq_sorter{}, collection, k);
+        auto nb_sorted = std::min<std::size_t>(k, collection.size());
+        CHECK( sorted_last == collection.begin() + nb_sorted );
+        CHECK( std::equal(collection.begin(), sorted_last, expected.begin()) );
+    }
+
+    SECTION( "partial_sort with forward iterators" )
+    {
+        std::forward_list<int> li(collection.begin(), collection.end());
+        auto sorted_last = cppsort::partial_sort(cppsort::merge_sorter{}, li, 100,
+                                                 std::greater<>{}, std::negate<>{});
+        CHECK( std::distance(li.begin(), sorted_last) == 100 );
+        CHECK( std::equal(li.begin(), sorted_last, expected.begin()) );
+    }
+
+    SECTION( "top_k" )
+    {
+        std::vector<int> res;
+        cppsort::top_k(collection, 100, std::back_inserter(res));
+        CHECK( std::equal(res.begin(), res.end(), expected.begin(), expected.begin() + 100) );
+
+        res.clear();
+        cppsort::top_k(collection, 50, std::back_inserter(res), std::greater<>{});
+        CHECK( std::equal(res.begin(), res.end(), expected.rbegin(), expected.rbegin() + 50) );
+
+        res.clear();
+        cppsort::top_k(collection, 20'000, std::back_inserter(res));
+        CHECK( res == expected );
+
+        res.clear();
+        cppsort::top_k(collection, 0, std::back_inserter(res));
+        CHECK( res.empty() );
+    }
+
+    SECTION( "top_k with input iterators" )
+    {
+        std::ostringstream oss;
+        for (int value: collection) {
+            oss << value << ' ';
+        }
+        std::istringstream iss(oss.str());
+
+        struct input_range
+        {
+            std::istream& stream;
+            auto begin() const { return std::istream_iterator<int>(stream); }
+            auto end() const { return std::istream_iterator<int>(); }
+        };
+
+        std::vector<int> res;
+        cppsort::top_k(input_range{iss}, 10, std::back_inserter(res), std::less<>{}, std::negate<>{});
+        CHECK( std::equal(res.begin(), res.end(), expected.rbegin(), expected.rbegin() + 10) );
+    }
+}
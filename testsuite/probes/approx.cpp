@@ -0,0 +1,105 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <forward_list>
+#include <functional>
+#include <iterator>
+#include <vector>
+#include <catch2/catch.hpp>
+#include <cpp-sort/probes/approx.h>
+#include "../distributions.h"
+
+TEST_CASE( "approximate presortedness measures", "[probe][approx]" )
+{
+    SECTION( "exact measure for small collections" )
+    {
+        std::vector<int> vec;
+        vec.reserve(500);
+        auto distribution = dist::shuffled{};
+        distribution(std::back_inserter(vec), 500);
+
+        CHECK( cppsort::probe::approx::enc(vec) == cppsort::probe::enc(vec) );
+        CHECK( cppsort::probe::approx::exc(vec) == cppsort::probe::exc(vec) );
+        CHECK( cppsort::probe::approx::ham(vec) == cppsort::probe::ham(vec) );
+        CHECK( cppsort::probe::approx::inv(vec) == cppsort::probe::inv(vec) );
+        CHECK( cppsort::probe::approx::max(vec) == cppsort::probe::max(vec) );
+        CHECK( cppsort::probe::approx::rem(vec) == cppsort::probe::rem(vec) );
+    }
+
+    SECTION( "sorted collection" )
+    {
+        std::forward_list<int> li;
+        auto distribution = dist::ascending{};
+        distribution(std::front_inserter(li), 50000);
+        li.reverse();
+
+        CHECK( cppsort::probe::approx::enc(li) == 0 );
+        CHECK( cppsort::probe::approx::exc(li) == 0 );
+        CHECK( cppsort::probe::approx::ham(li) == 0 );
+        CHECK( cppsort::probe::approx::inv(li) == 0 );
+        CHECK( cppsort::probe::approx::max(li) == 0 );
+        CHECK( cppsort::probe::approx::rem(li) == 0 );
+    }
+
+    SECTION( "reversed collection" )
+    {
+        std::vector<int> vec;
+        vec.reserve(50000);
+        auto distribution = dist::descending{};
+        distribution(std::back_inserter(vec), 50000);
+
+        auto size = static_cast<std::ptrdiff_t>(vec.size());
+        CHECK( cppsort::probe::approx::inv(vec) == size * (size - 1) / 2 );
+        CHECK( cppsort::probe::approx::inv(vec, std::greater<>{}) == 0 );
+        CHECK( cppsort::probe::approx::rem(vec) >= size * 99 / 100 );
+    }
+
+    SECTION( "estimation error" )
+    {
+        std::vector<int> vec;
+        vec.reserve(50000);
+        auto distribution = dist::shuffled{};
+        distribution(std::back_inserter(vec), 50000);
+
+        // The normalized measures should be close to the exact ones
+        auto size = static_cast<double>(vec.size());
+        auto pairs = size * (size - 1) / 2;
+        cppsort::probe::approx::inv_probe inv(0.05, 0.99);
+        CHECK( std::abs(inv(vec) - cppsort::probe::inv(vec)) / pairs < 0.05 );
+        cppsort::probe::approx::rem_probe rem(0.05, 0.99);
+        CHECK( std::abs(rem(vec) - cppsort::probe::rem(vec)) / size < 0.05 );
+        cppsort::probe::approx::ham_probe ham(0.05, 0.99);
+        CHECK( std::abs(ham(vec) - cppsort::probe::ham(vec)) / size < 0.05 );
+        cppsort::probe::approx::max_probe max(0.05, 0.99);
+        CHECK( std::abs(max(vec) - cppsort::probe::max(vec)) / size < 0.05 );
+    }
+
+    SECTION( "sample size" )
+    {
+        CHECK( cppsort::probe::approx::inv_probe::sample_size_for(0.05, 0.95) == 738 );
+        CHECK( cppsort::probe::approx::inv_probe::sample_size_for(0.01, 0.99) == 26492 );
+    }
+}
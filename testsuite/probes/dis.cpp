@@ -21,8 +21,11 @@
  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
  * THE SOFTWARE.
  */
+#include <algorithm>
+#include <cstddef>
 #include <forward_list>
 #include <iterator>
+#include <random>
 #include <vector>
 #include <catch2/catch.hpp>
 #include <cpp-sort/probes/dis.h>
@@ -56,4 +59,31 @@ TEST_CASE( "presortedness measure: dis", "[probe][dis]" )
         CHECK( cppsort::probe::dis(li) == 10 );
         CHECK( cppsort::probe::dis(std::begin(li), std::end(li)) == 10 );
     }
+
+    SECTION( "naive algorithm equivalence" )
+    {
+        // Compare the result against the quadratic definition of
+        // the measure on sequences containing many duplicates
+        auto naive_dis = [](const std::vector<int>& vec) {
+            std::ptrdiff_t max_dist = 0;
+            for (std::size_t i = 0 ; i < vec.size() ; ++i) {
+                for (std::size_t j = i + 1 ; j < vec.size() ; ++j) {
+                    if (vec[j] < vec[i]) {
+                        max_dist = std::max(max_dist, static_cast<std::ptrdiff_t>(j - i));
+                    }
+                }
+            }
+            return max_dist;
+        };
+
+        std::mt19937 engine(Catch::rngSeed());
+        for (int size = 0 ; size < 200 ; ++size) {
+            std::uniform_int_distribution<int> distribution(0, size / 4 + 1);
+            std::vector<int> vec;
+            for (int i = 0 ; i < size ; ++i) {
+                vec.push_back(distribution(engine));
+            }
+            CHECK( cppsort::probe::dis(vec) == naive_dis(vec) );
+        }
+    }
 }
@@ -21,8 +21,11 @@
  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
  * THE SOFTWARE.
  */
+#include <algorithm>
+#include <cstddef>
 #include <forward_list>
 #include <iterator>
+#include <random>
 #include <vector>
 #include <catch2/catch.hpp>
 #include <cpp-sort/probes/osc.h>
@@ -60,4 +63,32 @@ TEST_CASE( "presortedness measure: osc", "[probe][osc]" )
         CHECK( cppsort::probe::osc(li) == 71 );
         CHECK( cppsort::probe::osc(std::begin(li), std::end(li)) == 71 );
     }
+
+    SECTION( "naive algorithm equivalence" )
+    {
+        // Compare the result against the quadratic definition of
+        // the measure on sequences containing many duplicates
+        auto naive_osc = [](const std::vector<int>& vec) {
+            std::ptrdiff_t count = 0;
+            for (auto value: vec) {
+                for (std::size_t i = 1 ; i < vec.size() ; ++i) {
+                    if (std::min(vec[i - 1], vec[i]) < value &&
+                        value < std::max(vec[i - 1], vec[i])) {
+                        ++count;
+                    }
+                }
+            }
+            return count;
+        };
+
+        std::mt19937 engine(Catch::rngSeed());
+        for (int size = 0 ; size < 200 ; ++size) {
+            std::uniform_int_distribution<int> distribution(0, size / 4 + 1);
+            std::vector<int> vec;
+            for (int i = 0 ; i < size ; ++i) {
+                vec.push_back(distribution(engine));
+            }
+            CHECK( cppsort::probe::osc(vec) == naive_osc(vec) );
+        }
+    }
 }
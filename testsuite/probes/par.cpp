@@ -21,7 +21,9 @@
  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
  * THE SOFTWARE.
  */
+#include <cstddef>
 #include <iterator>
+#include <random>
 #include <vector>
 #include <catch2/catch.hpp>
 #include <cpp-sort/probes/par.h>
@@ -55,4 +57,38 @@ TEST_CASE( "presortedness measure: par", "[probe][par]" )
         CHECK( cppsort::probe::par(vec) == 10 );
         CHECK( cppsort::probe::par(std::begin(vec), std::end(vec)) == 10 );
     }
+
+    SECTION( "naive algorithm equivalence" )
+    {
+        // Compare the result against the quadratic definition of
+        // the measure on sequences containing many duplicates
+        auto naive_par = [](const std::vector<int>& vec) {
+            // Smallest p such that the sequence is p-sorted
+            auto is_p_sorted = [&vec](std::size_t p) {
+                for (std::size_t j = p ; j < vec.size() ; ++j) {
+                    for (std::size_t i = 0 ; i < j - p ; ++i) {
+                        if (vec[j] < vec[i]) {
+                            return false;
+                        }
+                    }
+                }
+                return true;
+            };
+            std::ptrdiff_t p = 0;
+            while (not is_p_sorted(static_cast<std::size_t>(p))) {
+                ++p;
+            }
+            return p;
+        };
+
+        std::mt19937 engine(Catch::rngSeed());
+        for (int size = 0 ; size < 200 ; ++size) {
+            std::uniform_int_distribution<int> distribution(0, size / 4 + 1);
+            std::vector<int> vec;
+            for (int i = 0 ; i < size ; ++i) {
+                vec.push_back(distribution(engine));
+            }
+            CHECK( cppsort::probe::par(vec) == naive_par(vec) );
+        }
+    }
 }
@@ -0,0 +1,99 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <random>
+#include <vector>
+#include <catch2/catch.hpp>
+#include <cpp-sort/sorters/pdq_sorter.h>
+#include <cpp-sort/sorters/quick_merge_sorter.h>
+#include <cpp-sort/sorters/quick_sorter.h>
+
+//
+// Small collections and partitions are sorted with sorting
+// networks when the comparison is branchless, test every size
+// handled by the runtime dispatch and a bit more
+//
+
+namespace
+{
+    struct wrapper
+    {
+        int value;
+    };
+
+    template<typename Sorter, typename Compare>
+    auto test_small_sizes(Compare compare)
+        -> void
+    {
+        std::mt19937 engine(Catch::rngSeed());
+        std::uniform_int_distribution<int> distribution(-20, 20);
+        for (int size = 0 ; size <= 70 ; ++size) {
+            std::vector<double> vec;
+            for (int i = 0 ; i < size ; ++i) {
+                vec.push_back(distribution(engine));
+            }
+            auto expected = vec;
+            std::sort(std::begin(expected), std::end(expected), compare);
+            Sorter{}(vec, compare);
+            CHECK( vec == expected );
+        }
+    }
+}
+
+TEMPLATE_TEST_CASE( "sorters with a sorting networks finisher", "[sorters][sorting_network_sorter]",
+                    cppsort::pdq_sorter,
+                    cppsort::quick_merge_sorter,
+                    cppsort::quick_sorter )
+{
+    using sorter = TestType;
+
+    SECTION( "branchless comparisons" )
+    {
+        test_small_sizes<sorter>(std::less<>{});
+        test_small_sizes<sorter>(std::greater<>{});
+    }
+
+    SECTION( "non-branchless comparison" )
+    {
+        test_small_sizes<sorter>([](double lhs, double rhs) { return lhs < rhs; });
+    }
+
+    SECTION( "projection" )
+    {
+        std::mt19937 engine(Catch::rngSeed());
+        std::uniform_int_distribution<int> distribution(-20, 20);
+        for (int size = 0 ; size <= 70 ; ++size) {
+            std::vector<wrapper> vec;
+            for (int i = 0 ; i < size ; ++i) {
+                vec.push_back({distribution(engine)});
+            }
+            sorter{}(vec, &wrapper::value);
+            CHECK( std::is_sorted(std::begin(vec), std::end(vec), [](auto lhs, auto rhs) {
+                return lhs.value < rhs.value;
+            }) );
+        }
+    }
+}
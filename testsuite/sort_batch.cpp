@@ -0,0 +1,134 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+#include <catch2/catch.hpp>
+#include <cpp-sort/sort_batch.h>
+#include <cpp-sort/sorters/pdq_sorter.h>
+
+namespace
+{
+    struct wrapper
+    {
+        int value;
+    };
+
+    // Random segments sizes, with many small ones
+    auto make_offsets(std::mt19937& engine, std::size_t nb_segments, int max_size)
+        -> std::vector<std::size_t>
+    {
+        std::uniform_int_distribution<int> distribution(0, max_size);
+        std::vector<std::size_t> offsets = { 0 };
+        for (std::size_t idx = 0 ; idx < nb_segments ; ++idx) {
+            offsets.push_back(offsets.back() + static_cast<std::size_t>(distribution(engine)));
+        }
+        return offsets;
+    }
+
+    template<typename T, typename Compare>
+    auto check_sort_batch(std::size_t nb_segments, int max_size,
+                          Compare compare, std::size_t nb_threads)
+        -> void
+    {
+        std::mt19937 engine(Catch::rngSeed());
+        auto offsets = make_offsets(engine, nb_segments, max_size);
+
+        std::uniform_int_distribution<int> distribution(-50, 50);
+        std::vector<T> collection;
+        for (std::size_t idx = 0 ; idx < offsets.back() ; ++idx) {
+            collection.push_back(static_cast<T>(distribution(engine)));
+        }
+
+        auto expected = collection;
+        for (std::size_t idx = 0 ; idx + 1 < offsets.size() ; ++idx) {
+            std::sort(expected.begin() + offsets[idx], expected.begin() + offsets[idx + 1], compare);
+        }
+
+        cppsort::sort_batch(cppsort::pdq_sorter{}, collection, offsets,
+                            compare, cppsort::utility::identity{}, nb_threads);
+        CHECK( collection == expected );
+    }
+}
+
+TEST_CASE( "sort_batch tests", "[sort_batch]" )
+{
+    SECTION( "arithmetic types" )
+    {
+        check_sort_batch<int>(1000, 70, std::less<>{}, 1);
+        check_sort_batch<int>(1000, 70, std::greater<>{}, 1);
+        check_sort_batch<double>(1000, 70, std::less<>{}, 1);
+        check_sort_batch<unsigned char>(1000, 70, std::greater<>{}, 1);
+        check_sort_batch<long long>(1000, 70, std::less<>{}, 1);
+    }
+
+    SECTION( "non-default comparison" )
+    {
+        check_sort_batch<int>(1000, 70, [](int lhs, int rhs) { return lhs < rhs; }, 1);
+    }
+
+    SECTION( "several threads" )
+    {
+        check_sort_batch<int>(50'000, 40, std::less<>{}, 4);
+        check_sort_batch<double>(50'000, 40, std::greater<>{}, 4);
+    }
+
+    SECTION( "projection" )
+    {
+        std::mt19937 engine(Catch::rngSeed());
+        auto offsets = make_offsets(engine, 500, 50);
+        std::uniform_int_distribution<int> distribution(-50, 50);
+        std::vector<wrapper> collection;
+        for (std::size_t idx = 0 ; idx < offsets.back() ; ++idx) {
+            collection.push_back({distribution(engine)});
+        }
+
+        cppsort::sort_batch(cppsort::pdq_sorter{}, collection, offsets, std::less<>{}, &wrapper::value);
+        for (std::size_t idx = 0 ; idx + 1 < offsets.size() ; ++idx) {
+            CHECK( std::is_sorted(collection.begin() + offsets[idx], collection.begin() + offsets[idx + 1],
+                                  [](const auto& lhs, const auto& rhs) { return lhs.value < rhs.value; }) );
+        }
+    }
+
+    SECTION( "strings" )
+    {
+        std::vector<std::string> collection = { "b", "a", "d", "c", "f", "e", "z", "y", "x" };
+        std::vector<int> offsets = { 0, 2, 2, 6, 9 };
+        cppsort::sort_batch(cppsort::pdq_sorter{}, collection, offsets);
+        std::vector<std::string> expected = { "a", "b", "c", "d", "e", "f", "x", "y", "z" };
+        CHECK( collection == expected );
+    }
+
+    SECTION( "no segment" )
+    {
+        std::vector<int> collection = { 3, 2, 1 };
+        std::vector<int> offsets = { 0 };
+        cppsort::sort_batch(cppsort::pdq_sorter{}, collection, offsets);
+        CHECK( collection == std::vector<int>{ 3, 2, 1 } );
+    }
+}
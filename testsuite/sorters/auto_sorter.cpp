@@ -0,0 +1,168 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <string>
+#include <vector>
+#include <catch2/catch.hpp>
+#include <cpp-sort/sorters/auto_sorter.h>
+#include <cpp-sort/sort.h>
+#include "../distributions.h"
+
+namespace
+{
+    // Decision table recording the choices of the default one
+    struct recording_table
+    {
+        cppsort::auto_sorter_choice* choice;
+
+        auto operator()(const cppsort::auto_sorter_stats& stats) const
+            -> cppsort::auto_sorter_choice
+        {
+            *choice = cppsort::default_auto_sorter_table{}(stats);
+            return *choice;
+        }
+    };
+
+    // Decision table always returning the same choice
+    struct forced_table
+    {
+        cppsort::auto_sorter_choice choice;
+
+        auto operator()(const cppsort::auto_sorter_stats&) const
+            -> cppsort::auto_sorter_choice
+        {
+            return choice;
+        }
+    };
+
+    struct wrapper
+    {
+        int value;
+    };
+}
+
+TEST_CASE( "auto_sorter tests", "[auto_sorter]" )
+{
+    auto choice = cppsort::auto_sorter_choice::pdq_sort;
+    auto sorter = cppsort::auto_sorter<recording_table>(recording_table{&choice});
+
+    SECTION( "small collection" )
+    {
+        std::vector<int> collection;
+        auto distribution = dist::shuffled{};
+        distribution(std::back_inserter(collection), 20);
+        cppsort::sort(sorter, collection);
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection)) );
+        CHECK( choice == cppsort::auto_sorter_choice::insertion_sort );
+    }
+
+    SECTION( "presorted collection" )
+    {
+        std::vector<int> collection;
+        auto distribution = dist::descending_sawtooth{};
+        distribution(std::back_inserter(collection), 10'000);
+        cppsort::sort(sorter, collection);
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection)) );
+        CHECK( choice == cppsort::auto_sorter_choice::verge_sort );
+    }
+
+    SECTION( "arithmetic keys" )
+    {
+        std::vector<int> collection;
+        auto distribution = dist::shuffled{};
+        distribution(std::back_inserter(collection), 10'000);
+        cppsort::sort(sorter, collection);
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection)) );
+        CHECK( choice == cppsort::auto_sorter_choice::ska_sort );
+    }
+
+    SECTION( "strings" )
+    {
+        std::vector<int> values;
+        auto distribution = dist::shuffled{};
+        distribution(std::back_inserter(values), 10'000);
+        std::vector<std::string> collection;
+        for (int value: values) {
+            collection.push_back(std::to_string(value));
+        }
+        cppsort::sort(sorter, collection, std::greater<>{});
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection), std::greater<>{}) );
+        CHECK( choice == cppsort::auto_sorter_choice::string_spread_sort );
+    }
+
+    SECTION( "projection" )
+    {
+        std::vector<int> values;
+        auto distribution = dist::shuffled{};
+        distribution(std::back_inserter(values), 10'000);
+        std::vector<wrapper> collection;
+        for (int value: values) {
+            collection.push_back({value});
+        }
+        cppsort::sort(sorter, collection, &wrapper::value);
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection),
+                              [](const auto& lhs, const auto& rhs) { return lhs.value < rhs.value; }) );
+        CHECK( choice == cppsort::auto_sorter_choice::ska_sort );
+    }
+
+    SECTION( "custom comparison" )
+    {
+        std::vector<int> collection;
+        auto distribution = dist::shuffled{};
+        distribution(std::back_inserter(collection), 10'000);
+        auto compare = [](int lhs, int rhs) { return lhs > rhs; };
+        cppsort::sort(sorter, collection, compare);
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection), compare) );
+        CHECK( choice == cppsort::auto_sorter_choice::pdq_sort );
+    }
+}
+
+TEST_CASE( "auto_sorter with a custom decision table", "[auto_sorter]" )
+{
+    std::vector<double> collection;
+    auto distribution = dist::shuffled{};
+    distribution(std::back_inserter(collection), 10'000);
+
+    SECTION( "unsuitable choice" )
+    {
+        // string_spread_sorter can't sort floating point numbers,
+        // auto_sorter falls back to pdq_sorter instead
+        auto sorter = cppsort::auto_sorter<forced_table>(
+            forced_table{cppsort::auto_sorter_choice::string_spread_sort}
+        );
+        cppsort::sort(sorter, collection);
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection)) );
+    }
+
+    SECTION( "forced algorithm" )
+    {
+        auto sorter = cppsort::auto_sorter<forced_table>(
+            forced_table{cppsort::auto_sorter_choice::verge_sort}
+        );
+        cppsort::sort(sorter, collection);
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection)) );
+    }
+}
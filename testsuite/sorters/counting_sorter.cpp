@@ -22,12 +22,18 @@
  * THE SOFTWARE.
  */
 #include <algorithm>
+#include <cstdint>
 #include <forward_list>
+#include <functional>
 #include <iterator>
+#include <limits>
 #include <list>
+#include <random>
+#include <string>
 #include <vector>
 #include <catch2/catch.hpp>
 #include <cpp-sort/sorters/counting_sorter.h>
+#include "../algorithm.h"
 #include "../distributions.h"
 
 TEST_CASE( "counting_sorter tests", "[counting_sorter]" )
@@ -91,3 +97,113 @@ TEST_CASE( "counting_sorter tests", "[counting_sorter]" )
         CHECK( std::is_sorted(std::begin(vec), std::end(vec)) );
     }
 }
+
+namespace
+{
+    struct record
+    {
+        std::uint16_t category;
+        int order;
+        std::string payload;
+    };
+
+    auto make_records(int size, int nb_categories)
+        -> std::vector<record>
+    {
+        std::mt19937 engine(Catch::rngSeed());
+        std::uniform_int_distribution<int> dist(0, nb_categories - 1);
+        std::vector<record> res; res.reserve(size);
+        for (int i = 0 ; i < size ; ++i) {
+            auto category = static_cast<std::uint16_t>(dist(engine));
+            res.push_back({ category, i, std::to_string(category) });
+        }
+        return res;
+    }
+
+    auto is_stably_sorted(const std::vector<record>& records, bool descending)
+        -> bool
+    {
+        return std::is_sorted(std::begin(records), std::end(records),
+                              [descending](const record& lhs, const record& rhs) {
+                                  if (lhs.category != rhs.category) {
+                                      return descending ? lhs.category > rhs.category
+                                                        : lhs.category < rhs.category;
+                                  }
+                                  return lhs.order < rhs.order;
+                              })
+            && std::all_of(std::begin(records), std::end(records), [](const record& rec) {
+                   return rec.payload == std::to_string(rec.category);
+               });
+    }
+}
+
+TEST_CASE( "counting_sorter with projections", "[counting_sorter][projection]" )
+{
+    SECTION( "stable sort of records" )
+    {
+        auto records = make_records(10'000, 300);
+        cppsort::counting_sort(records, &record::category);
+        CHECK( is_stably_sorted(records, false) );
+    }
+
+    SECTION( "stable reverse sort of records" )
+    {
+        auto records = make_records(10'000, 300);
+        cppsort::counting_sort(records, std::greater<>{}, &record::category);
+        CHECK( is_stably_sorted(records, true) );
+    }
+
+    SECTION( "records with forward iterators" )
+    {
+        auto records = make_records(10'000, 300);
+        std::forward_list<record> li(std::begin(records), std::end(records));
+        cppsort::counting_sort(li, &record::category);
+        CHECK( helpers::is_sorted(std::begin(li), std::end(li),
+                                  std::less<>{}, &record::category) );
+    }
+
+    SECTION( "parallel histograms" )
+    {
+        // Big enough for the histograms to be computed by several threads
+        auto records = make_records(1'500'000, 1 << 16);
+        cppsort::counting_sort(records, &record::category);
+        CHECK( is_stably_sorted(records, false) );
+    }
+}
+
+TEST_CASE( "counting_sorter with big key ranges", "[counting_sorter]" )
+{
+    // Too many counters would be needed, another algorithm is used
+
+    std::vector<int> vec; vec.reserve(1000);
+    std::mt19937 engine(Catch::rngSeed());
+    std::uniform_int_distribution<int> dist(std::numeric_limits<int>::min(),
+                                            std::numeric_limits<int>::max());
+    for (int i = 0 ; i < 998 ; ++i) {
+        vec.push_back(dist(engine));
+    }
+    vec.push_back(std::numeric_limits<int>::min());
+    vec.push_back(std::numeric_limits<int>::max());
+    std::shuffle(std::begin(vec), std::end(vec), engine);
+
+    SECTION( "values" )
+    {
+        cppsort::counting_sort(vec);
+        CHECK( std::is_sorted(std::begin(vec), std::end(vec)) );
+    }
+
+    SECTION( "reverse values with forward iterators" )
+    {
+        std::forward_list<int> li(std::begin(vec), std::end(vec));
+        cppsort::counting_sort(li, std::greater<>{});
+        CHECK( std::is_sorted(std::begin(li), std::end(li), std::greater<>{}) );
+    }
+
+    SECTION( "projection" )
+    {
+        auto projection = [](int value) { return value / 3; };
+        cppsort::counting_sort(vec, std::greater<>{}, projection);
+        CHECK( helpers::is_sorted(std::begin(vec), std::end(vec),
+                                  std::greater<>{}, projection) );
+    }
+}
@@ -0,0 +1,154 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <vector>
+#include <catch2/catch.hpp>
+#include <cpp-sort/sorters/external_sorter.h>
+#include <cpp-sort/sorters/merge_sorter.h>
+#include <cpp-sort/sort.h>
+#include "../distributions.h"
+
+namespace
+{
+    struct wrapper
+    {
+        int value;
+        std::size_t order;
+    };
+
+    // Big enough for several runs to be merged at once
+    // within a small memory budget
+    struct big_element
+    {
+        int value;
+        char payload[1020];
+    };
+}
+
+TEST_CASE( "external_sorter tests", "[external_sorter]" )
+{
+    // The memory budgets are small enough to force the
+    // collections to be sorted by runs spilled to disk
+
+    std::vector<int> collection;
+    collection.reserve(50'000);
+    auto distribution = dist::shuffled_16_values{};
+    distribution(std::back_inserter(collection), 50'000);
+    auto copy = collection;
+    std::sort(std::begin(copy), std::end(copy));
+
+    SECTION( "runs merged back" )
+    {
+        // Many small runs need several merge passes
+        auto budget = GENERATE(as<std::size_t>{}, 4'000, 20'000, 65'536);
+        cppsort::sort(cppsort::external_sorter<>(budget), collection);
+        CHECK( collection == copy );
+    }
+
+    SECTION( "one element per run" )
+    {
+        collection.resize(2'000);
+        copy.assign(std::begin(collection), std::end(collection));
+        std::sort(std::begin(copy), std::end(copy));
+        cppsort::sort(cppsort::external_sorter<>(1), collection);
+        CHECK( collection == copy );
+    }
+
+    SECTION( "collection fitting in memory" )
+    {
+        cppsort::sort(cppsort::external_sorter<>(1'000'000), collection);
+        CHECK( collection == copy );
+    }
+
+    SECTION( "with compare and projection" )
+    {
+        cppsort::sort(cppsort::external_sorter<>(10'000), collection,
+                      std::greater<>{}, std::negate<>{});
+        CHECK( collection == copy );
+    }
+
+    SECTION( "with a temporary directory" )
+    {
+        cppsort::sort(cppsort::external_sorter<>(10'000, "."), collection);
+        CHECK( collection == copy );
+    }
+}
+
+TEST_CASE( "external_sorter single merge pass", "[external_sorter]" )
+{
+    // Several runs fit in the memory budget at once, so
+    // that they are merged back in a single pass
+
+    std::vector<int> values;
+    values.reserve(2'000);
+    auto distribution = dist::shuffled{};
+    distribution(std::back_inserter(values), 2'000);
+
+    std::vector<big_element> collection;
+    collection.reserve(2'000);
+    for (int value: values) {
+        big_element elem;
+        elem.value = value;
+        elem.payload[0] = static_cast<char>(value);
+        collection.push_back(elem);
+    }
+
+    cppsort::sort(cppsort::external_sorter<>(512 * 1024), collection, &big_element::value);
+    std::sort(std::begin(values), std::end(values));
+    for (std::size_t idx = 0 ; idx < values.size() ; ++idx) {
+        CHECK( collection[idx].value == values[idx] );
+        CHECK( collection[idx].payload[0] == static_cast<char>(values[idx]) );
+    }
+}
+
+TEST_CASE( "external_sorter stability", "[external_sorter][is_stable]" )
+{
+    // Equivalent elements spread over several runs come back
+    // in their original order when the runs are sorted by a
+    // stable sorter
+
+    std::vector<int> values;
+    values.reserve(50'000);
+    auto distribution = dist::shuffled_16_values{};
+    distribution(std::back_inserter(values), 50'000);
+
+    std::vector<wrapper> collection;
+    collection.reserve(50'000);
+    for (std::size_t idx = 0 ; idx < values.size() ; ++idx) {
+        collection.push_back({values[idx], idx});
+    }
+
+    using sorter = cppsort::external_sorter<cppsort::merge_sorter>;
+    static_assert(cppsort::is_always_stable_v<sorter>, "");
+
+    cppsort::sort(sorter(30'000), collection, &wrapper::value);
+    CHECK( std::is_sorted(std::begin(collection), std::end(collection),
+                          [](const wrapper& lhs, const wrapper& rhs) {
+                              return lhs.value < rhs.value
+                                  || (lhs.value == rhs.value && lhs.order < rhs.order);
+                          }) );
+}
@@ -0,0 +1,167 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017-2019 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <vector>
+#include <catch2/catch.hpp>
+#include <cpp-sort/sorters/lsd_radix_sorter.h>
+#include <cpp-sort/sort.h>
+#include <cpp-sort/utility/buffer.h>
+#include <cpp-sort/utility/functional.h>
+
+namespace
+{
+    struct wrapper
+    {
+        int value;
+        int order;
+    };
+}
+
+TEST_CASE( "lsd_radix_sorter tests", "[lsd_radix_sorter]" )
+{
+    // Pseudo-random number engine
+    std::mt19937_64 engine(Catch::rngSeed());
+
+    SECTION( "sort with int iterable" )
+    {
+        std::vector<int> vec(100'000);
+        std::iota(std::begin(vec), std::end(vec), -50'000);
+        std::shuffle(std::begin(vec), std::end(vec), engine);
+        cppsort::sort(cppsort::lsd_radix_sort, vec);
+        CHECK( std::is_sorted(std::begin(vec), std::end(vec)) );
+    }
+
+    SECTION( "sort with unsigned long long iterators" )
+    {
+        std::vector<unsigned long long> vec;
+        for (int i = 0 ; i < 100'000 ; ++i) {
+            vec.push_back(engine());
+        }
+        cppsort::sort(cppsort::lsd_radix_sort, std::begin(vec), std::end(vec));
+        CHECK( std::is_sorted(std::begin(vec), std::end(vec)) );
+    }
+
+    SECTION( "sort with float iterable" )
+    {
+        std::vector<float> vec;
+        std::uniform_real_distribution<float> distribution(-1000.0f, 1000.0f);
+        for (int i = 0 ; i < 100'000 ; ++i) {
+            vec.push_back(distribution(engine));
+        }
+        vec.push_back(std::numeric_limits<float>::infinity());
+        vec.push_back(-std::numeric_limits<float>::infinity());
+        std::shuffle(std::begin(vec), std::end(vec), engine);
+        cppsort::sort(cppsort::lsd_radix_sort, vec);
+        CHECK( std::is_sorted(std::begin(vec), std::end(vec)) );
+    }
+
+    SECTION( "sort with double iterators" )
+    {
+        std::vector<double> vec;
+        std::uniform_real_distribution<double> distribution(-1e10, 1e10);
+        for (int i = 0 ; i < 100'000 ; ++i) {
+            vec.push_back(distribution(engine));
+        }
+        cppsort::sort(cppsort::lsd_radix_sort, std::begin(vec), std::end(vec));
+        CHECK( std::is_sorted(std::begin(vec), std::end(vec)) );
+    }
+
+    SECTION( "sort with pointers" )
+    {
+        std::vector<int> values(10'000);
+        std::vector<int*> vec;
+        for (auto& value: values) {
+            vec.push_back(&value);
+        }
+        std::shuffle(std::begin(vec), std::end(vec), engine);
+        cppsort::sort(cppsort::lsd_radix_sort, vec);
+        CHECK( std::is_sorted(std::begin(vec), std::end(vec)) );
+    }
+
+    SECTION( "sort with deque and char" )
+    {
+        std::deque<char> deq;
+        std::uniform_int_distribution<int> distribution(0, 127);
+        for (int i = 0 ; i < 10'000 ; ++i) {
+            deq.push_back(static_cast<char>(distribution(engine)));
+        }
+        cppsort::sort(cppsort::lsd_radix_sort, deq);
+        CHECK( std::is_sorted(std::begin(deq), std::end(deq)) );
+    }
+
+    SECTION( "skip constant digits" )
+    {
+        // Only the lowest digit of the keys is different: the
+        // elements end up in the buffer after a single pass and
+        // have to be moved back to the collection
+        std::vector<std::uint64_t> vec;
+        std::uniform_int_distribution<std::uint64_t> distribution(0, 255);
+        for (int i = 0 ; i < 10'000 ; ++i) {
+            vec.push_back(0x1234567800000000 | distribution(engine));
+        }
+        cppsort::sort(cppsort::lsd_radix_sort, vec);
+        CHECK( std::is_sorted(std::begin(vec), std::end(vec)) );
+    }
+
+    SECTION( "stability and projection" )
+    {
+        std::vector<wrapper> vec(10'000);
+        std::uniform_int_distribution<int> distribution(-1'000, 1'000);
+        int count = 0;
+        for (auto& wrap: vec) {
+            wrap.value = distribution(engine);
+            wrap.order = count++;
+        }
+        cppsort::sort(cppsort::lsd_radix_sort, vec, &wrapper::value);
+        CHECK( std::is_sorted(std::begin(vec), std::end(vec), [](const wrapper& lhs, const wrapper& rhs) {
+            return lhs.value < rhs.value || (lhs.value == rhs.value && lhs.order < rhs.order);
+        }) );
+    }
+
+    SECTION( "buffer too small for the collection" )
+    {
+        // Falls back to a stable comparison sort
+        using sorter = cppsort::lsd_radix_sorter<
+            cppsort::utility::dynamic_buffer<cppsort::utility::half>
+        >;
+
+        std::vector<wrapper> vec(10'000);
+        std::uniform_int_distribution<int> distribution(-1'000, 1'000);
+        int count = 0;
+        for (auto& wrap: vec) {
+            wrap.value = distribution(engine);
+            wrap.order = count++;
+        }
+        cppsort::sort(sorter{}, vec, &wrapper::value);
+        CHECK( std::is_sorted(std::begin(vec), std::end(vec), [](const wrapper& lhs, const wrapper& rhs) {
+            return lhs.value < rhs.value || (lhs.value == rhs.value && lhs.order < rhs.order);
+        }) );
+    }
+}
@@ -0,0 +1,104 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <algorithm>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+#include <catch2/catch.hpp>
+#include <cpp-sort/sorters/packed_string_sorter.h>
+#include <cpp-sort/sort.h>
+
+namespace
+{
+    struct wrapper
+    {
+        std::string value;
+    };
+}
+
+TEST_CASE( "packed_string_sorter tests", "[packed_string_sorter]" )
+{
+    // Pseudo-random number engine
+    std::mt19937_64 engine(Catch::rngSeed());
+
+    SECTION( "strings with a long common prefix" )
+    {
+        std::vector<std::string> vec;
+        for (int i = 0 ; i < 50'000 ; ++i) {
+            auto s = std::to_string(i);
+            vec.push_back(std::string(60 - s.size(), '0') + std::move(s));
+        }
+        std::shuffle(std::begin(vec), std::end(vec), engine);
+        cppsort::sort(cppsort::packed_string_sort, vec);
+        CHECK( std::is_sorted(std::begin(vec), std::end(vec)) );
+    }
+
+    SECTION( "strings that are prefixes of other strings" )
+    {
+        // Embedded null characters can't be mistaken for the
+        // padding of the packed keys of shorter strings
+        std::vector<std::string> vec;
+        std::uniform_int_distribution<int> size_distribution(0, 30);
+        std::uniform_int_distribution<int> char_distribution(0, 3);
+        const char chars[] = { '\0', 'a', 'b', '\xff' };
+        for (int i = 0 ; i < 20'000 ; ++i) {
+            std::string s(size_distribution(engine), 'a');
+            for (auto& c: s) {
+                c = chars[char_distribution(engine)];
+            }
+            vec.push_back(std::move(s));
+        }
+        auto copy = vec;
+        cppsort::sort(cppsort::packed_string_sort, vec);
+        std::sort(std::begin(copy), std::end(copy));
+        CHECK( vec == copy );
+    }
+
+    SECTION( "many duplicates" )
+    {
+        std::vector<std::string> vec;
+        std::uniform_int_distribution<int> distribution(0, 50);
+        for (int i = 0 ; i < 20'000 ; ++i) {
+            vec.push_back("some/long/shared/path/" + std::to_string(distribution(engine)));
+        }
+        auto copy = vec;
+        cppsort::sort(cppsort::packed_string_sort, vec);
+        std::sort(std::begin(copy), std::end(copy));
+        CHECK( vec == copy );
+    }
+
+    SECTION( "sort with projection" )
+    {
+        std::vector<wrapper> vec;
+        for (int i = 0 ; i < 10'000 ; ++i) {
+            vec.push_back({ std::to_string(i) });
+        }
+        std::shuffle(std::begin(vec), std::end(vec), engine);
+        cppsort::sort(cppsort::packed_string_sort, vec, &wrapper::value);
+        CHECK( std::is_sorted(std::begin(vec), std::end(vec), [](const auto& lhs, const auto& rhs) {
+            return lhs.value < rhs.value;
+        }) );
+    }
+}
@@ -0,0 +1,163 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <catch2/catch.hpp>
+#include <cpp-sort/adapters/stable_adapter.h>
+#include <cpp-sort/sorters/parallel_merge_sorter.h>
+#include <cpp-sort/sorters/parallel_pdq_sorter.h>
+#include <cpp-sort/sort.h>
+#include "../distributions.h"
+
+namespace
+{
+    struct wrapper
+    {
+        int value;
+        std::size_t order;
+    };
+
+    auto operator<(const wrapper& lhs, const wrapper& rhs)
+        -> bool
+    {
+        if (lhs.value < rhs.value) {
+            return true;
+        }
+        if (rhs.value < lhs.value) {
+            return false;
+        }
+        return lhs.order < rhs.order;
+    }
+}
+
+TEST_CASE( "parallel_merge_sorter tests", "[parallel_merge_sorter]" )
+{
+    // The collections need to be big enough for the
+    // algorithm to actually split the work between
+    // several threads, an odd number of threads also
+    // leaves a lone run during the merge rounds
+
+    std::vector<int> collection;
+    collection.reserve(100'000);
+    auto nb_threads = GENERATE(as<std::size_t>{}, 2, 3, 4, 7);
+    auto sorter = cppsort::parallel_merge_sorter(nb_threads);
+
+    SECTION( "shuffled distribution" )
+    {
+        auto distribution = dist::shuffled{};
+        distribution(std::back_inserter(collection), 100'000);
+        cppsort::sort(sorter, collection);
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection)) );
+    }
+
+    SECTION( "shuffled_16_values distribution" )
+    {
+        auto distribution = dist::shuffled_16_values{};
+        distribution(std::back_inserter(collection), 100'000);
+        cppsort::sort(sorter, collection);
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection)) );
+    }
+
+    SECTION( "descending distribution with compare" )
+    {
+        auto distribution = dist::descending{};
+        distribution(std::back_inserter(collection), 100'000);
+        cppsort::sort(sorter, collection, std::greater<>{});
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection), std::greater<>{}) );
+    }
+
+    SECTION( "shuffled distribution with projection" )
+    {
+        auto distribution = dist::shuffled{};
+        distribution(std::back_inserter(collection), 100'000);
+        cppsort::sort(sorter, collection, std::negate<>{});
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection), std::greater<>{}) );
+    }
+}
+
+TEST_CASE( "parallel_merge_sorter stability", "[parallel_merge_sorter][is_stable]" )
+{
+    // Few different values make sure that equivalent elements
+    // end up in different chunks and cross slice boundaries
+
+    std::vector<int> values;
+    values.reserve(100'000);
+    auto distribution = dist::shuffled_16_values{};
+    distribution(std::back_inserter(values), 100'000);
+
+    std::vector<wrapper> collection;
+    collection.reserve(100'000);
+    for (std::size_t idx = 0 ; idx < values.size() ; ++idx) {
+        collection.push_back({values[idx], idx});
+    }
+
+    SECTION( "parallel_merge_sorter" )
+    {
+        auto nb_threads = GENERATE(as<std::size_t>{}, 2, 3, 5, 8);
+        cppsort::sort(cppsort::parallel_merge_sorter(nb_threads), collection, &wrapper::value);
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection)) );
+    }
+
+    SECTION( "stable_adapter<parallel_pdq_sorter>" )
+    {
+        using sorter = cppsort::stable_adapter<cppsort::parallel_pdq_sorter>;
+        cppsort::sort(sorter(cppsort::parallel_pdq_sorter(4)), collection, &wrapper::value);
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection)) );
+    }
+}
+
+TEST_CASE( "parallel_merge_sorter exception propagation", "[parallel_merge_sorter]" )
+{
+    // An exception thrown from any of the threads should be
+    // propagated to the calling thread, the elements already
+    // moved to the auxiliary buffer must be destroyed
+
+    std::vector<int> values;
+    values.reserve(50'000);
+    auto distribution = dist::shuffled{};
+    distribution(std::back_inserter(values), 50'000);
+
+    std::vector<std::string> collection;
+    collection.reserve(50'000);
+    for (int value: values) {
+        collection.push_back(std::to_string(value));
+    }
+
+    std::atomic<int> count(0);
+    auto throwing_projection = [&count](const std::string& value) -> const std::string& {
+        if (value == "42" && ++count > 2) {
+            throw std::runtime_error("projection failure");
+        }
+        return value;
+    };
+
+    auto sorter = cppsort::parallel_merge_sorter(4);
+    CHECK_THROWS_AS( sorter(collection, throwing_projection), std::runtime_error );
+}
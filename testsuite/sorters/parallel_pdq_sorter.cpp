@@ -0,0 +1,116 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+#include <catch2/catch.hpp>
+#include <cpp-sort/sorters/parallel_pdq_sorter.h>
+#include <cpp-sort/sort.h>
+#include "../distributions.h"
+
+TEST_CASE( "parallel_pdq_sorter tests", "[parallel_pdq_sorter]" )
+{
+    // The collections need to be big enough for the
+    // algorithm to actually split the work between
+    // several threads
+
+    std::vector<int> collection;
+    collection.reserve(100'000);
+    auto sorter = cppsort::parallel_pdq_sorter(4);
+
+    SECTION( "shuffled distribution" )
+    {
+        auto distribution = dist::shuffled{};
+        distribution(std::back_inserter(collection), 100'000);
+        cppsort::sort(sorter, collection);
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection)) );
+    }
+
+    SECTION( "shuffled_16_values distribution" )
+    {
+        auto distribution = dist::shuffled_16_values{};
+        distribution(std::back_inserter(collection), 100'000);
+        cppsort::sort(sorter, collection);
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection)) );
+    }
+
+    SECTION( "pipe_organ distribution" )
+    {
+        auto distribution = dist::pipe_organ{};
+        distribution(std::back_inserter(collection), 100'000);
+        cppsort::sort(sorter, collection);
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection)) );
+    }
+
+    SECTION( "descending distribution with compare" )
+    {
+        auto distribution = dist::descending{};
+        distribution(std::back_inserter(collection), 100'000);
+        cppsort::sort(sorter, collection, std::greater<>{});
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection), std::greater<>{}) );
+    }
+
+    SECTION( "shuffled distribution with projection" )
+    {
+        auto distribution = dist::shuffled{};
+        distribution(std::back_inserter(collection), 100'000);
+        cppsort::sort(sorter, collection, std::negate<>{});
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection), std::greater<>{}) );
+    }
+
+    SECTION( "same result as pdq_sorter" )
+    {
+        auto distribution = dist::alternating_16_values{};
+        distribution(std::back_inserter(collection), 100'000);
+        auto copy = collection;
+        cppsort::sort(sorter, collection);
+        std::sort(std::begin(copy), std::end(copy));
+        CHECK( collection == copy );
+    }
+}
+
+TEST_CASE( "parallel_pdq_sorter exception propagation", "[parallel_pdq_sorter]" )
+{
+    // An exception thrown from any of the threads should be
+    // propagated to the calling thread
+
+    std::vector<int> collection;
+    collection.reserve(100'000);
+    auto distribution = dist::shuffled{};
+    distribution(std::back_inserter(collection), 100'000);
+
+    std::atomic<int> count(0);
+    auto throwing_projection = [&count](int value) {
+        if (value == 42 && ++count > 2) {
+            throw std::runtime_error("projection failure");
+        }
+        return value;
+    };
+
+    auto sorter = cppsort::parallel_pdq_sorter(4);
+    CHECK_THROWS_AS( sorter(collection, throwing_projection), std::runtime_error );
+}
@@ -0,0 +1,165 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include <catch2/catch.hpp>
+#include <cpp-sort/sorters/parallel_ska_sorter.h>
+#include <cpp-sort/sort.h>
+#include "../distributions.h"
+
+TEST_CASE( "parallel_ska_sorter tests", "[parallel_ska_sorter]" )
+{
+    // The collections need to be big enough for the
+    // algorithm to actually split the work between
+    // several threads, an odd number of threads also
+    // gives stripes of uneven sizes
+
+    // Pseudo-random number engine
+    std::mt19937_64 engine(Catch::rngSeed());
+
+    auto nb_threads = GENERATE(as<std::size_t>{}, 2, 3, 4, 7);
+    auto sorter = cppsort::parallel_ska_sorter(nb_threads);
+
+    SECTION( "shuffled distribution" )
+    {
+        std::vector<int> collection;
+        collection.reserve(500'000);
+        auto distribution = dist::shuffled{};
+        distribution(std::back_inserter(collection), 500'000);
+        cppsort::sort(sorter, collection);
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection)) );
+    }
+
+    SECTION( "shuffled_16_values distribution" )
+    {
+        std::vector<int> collection;
+        collection.reserve(500'000);
+        auto distribution = dist::shuffled_16_values{};
+        distribution(std::back_inserter(collection), 500'000);
+        cppsort::sort(sorter, collection);
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection)) );
+    }
+
+    SECTION( "shuffled distribution with projection" )
+    {
+        std::vector<int> collection;
+        collection.reserve(500'000);
+        auto distribution = dist::shuffled{};
+        distribution(std::back_inserter(collection), 500'000);
+        cppsort::sort(sorter, collection, std::negate<>{});
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection), std::greater<>{}) );
+    }
+
+    SECTION( "uniformly distributed 64-bit keys" )
+    {
+        std::vector<std::uint64_t> collection;
+        for (int i = 0 ; i < 500'000 ; ++i) {
+            collection.push_back(engine());
+        }
+        auto copy = collection;
+        cppsort::sort(sorter, collection);
+        std::sort(std::begin(copy), std::end(copy));
+        CHECK( collection == copy );
+    }
+
+    SECTION( "64-bit keys with constant high bytes" )
+    {
+        // The first bytes don't split the collection, which
+        // is only really partitioned from the fifth byte on
+        std::vector<std::uint64_t> collection;
+        std::uniform_int_distribution<std::uint64_t> distribution(0, 1'000'000);
+        for (int i = 0 ; i < 500'000 ; ++i) {
+            collection.push_back(distribution(engine));
+        }
+        auto copy = collection;
+        cppsort::sort(sorter, collection);
+        std::sort(std::begin(copy), std::end(copy));
+        CHECK( collection == copy );
+    }
+
+    SECTION( "float keys" )
+    {
+        std::vector<float> collection;
+        std::uniform_real_distribution<float> distribution(-1e6f, 1e6f);
+        for (int i = 0 ; i < 500'000 ; ++i) {
+            collection.push_back(distribution(engine));
+        }
+        cppsort::sort(sorter, collection);
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection)) );
+    }
+
+#ifdef __SIZEOF_INT128__
+    SECTION( "unsigned int128 keys" )
+    {
+        std::vector<__uint128_t> collection(500'000);
+        std::iota(std::begin(collection), std::end(collection), __uint128_t(0));
+        std::shuffle(std::begin(collection), std::end(collection), engine);
+        cppsort::sort(sorter, collection);
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection)) );
+    }
+#endif
+
+    SECTION( "composite keys are sorted sequentially" )
+    {
+        std::vector<std::pair<int, std::string>> collection;
+        for (int i = 0 ; i < 10'000 ; ++i) {
+            collection.emplace_back(i % 100, std::to_string(i));
+        }
+        std::shuffle(std::begin(collection), std::end(collection), engine);
+        cppsort::sort(sorter, collection);
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection)) );
+    }
+}
+
+TEST_CASE( "parallel_ska_sorter exception propagation", "[parallel_ska_sorter]" )
+{
+    // An exception thrown from any of the threads should be
+    // propagated to the calling thread
+
+    std::vector<int> collection;
+    collection.reserve(500'000);
+    auto distribution = dist::shuffled{};
+    distribution(std::back_inserter(collection), 500'000);
+
+    std::atomic<int> count(0);
+    auto throwing_projection = [&count](int value) {
+        if (value == 42 && ++count > 2) {
+            throw std::runtime_error("projection failure");
+        }
+        return value;
+    };
+
+    auto sorter = cppsort::parallel_ska_sorter(4);
+    CHECK_THROWS_AS( sorter(collection, throwing_projection), std::runtime_error );
+}
@@ -0,0 +1,135 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <vector>
+#include <catch2/catch.hpp>
+#include <cpp-sort/sorters/parallel_tim_sorter.h>
+#include <cpp-sort/sort.h>
+#include "../distributions.h"
+
+namespace
+{
+    struct wrapper
+    {
+        int value;
+        std::size_t order;
+    };
+
+    auto operator<(const wrapper& lhs, const wrapper& rhs)
+        -> bool
+    {
+        if (lhs.value < rhs.value) {
+            return true;
+        }
+        if (rhs.value < lhs.value) {
+            return false;
+        }
+        return lhs.order < rhs.order;
+    }
+}
+
+TEST_CASE( "parallel_tim_sorter tests", "[parallel_tim_sorter]" )
+{
+    // The collections need to be big enough for the
+    // algorithm to actually split the work between
+    // several threads, the presorted distributions
+    // have runs crossing the boundaries of the chunks
+
+    std::vector<int> collection;
+    collection.reserve(100'000);
+    auto nb_threads = GENERATE(as<std::size_t>{}, 2, 3, 4, 7);
+    auto sorter = cppsort::parallel_tim_sorter(nb_threads);
+
+    SECTION( "shuffled distribution" )
+    {
+        auto distribution = dist::shuffled{};
+        distribution(std::back_inserter(collection), 100'000);
+        cppsort::sort(sorter, collection);
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection)) );
+    }
+
+    SECTION( "ascending distribution" )
+    {
+        auto distribution = dist::ascending{};
+        distribution(std::back_inserter(collection), 100'000);
+        cppsort::sort(sorter, collection);
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection)) );
+    }
+
+    SECTION( "descending distribution" )
+    {
+        auto distribution = dist::descending{};
+        distribution(std::back_inserter(collection), 100'000);
+        cppsort::sort(sorter, collection);
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection)) );
+    }
+
+    SECTION( "pipe_organ distribution" )
+    {
+        auto distribution = dist::pipe_organ{};
+        distribution(std::back_inserter(collection), 100'000);
+        cppsort::sort(sorter, collection);
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection)) );
+    }
+
+    SECTION( "ascending_sawtooth distribution with compare" )
+    {
+        auto distribution = dist::ascending_sawtooth{};
+        distribution(std::back_inserter(collection), 100'000);
+        cppsort::sort(sorter, collection, std::greater<>{});
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection), std::greater<>{}) );
+    }
+
+    SECTION( "push_middle distribution with projection" )
+    {
+        auto distribution = dist::push_middle{};
+        distribution(std::back_inserter(collection), 100'000);
+        cppsort::sort(sorter, collection, std::negate<>{});
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection), std::greater<>{}) );
+    }
+}
+
+TEST_CASE( "parallel_tim_sorter stability", "[parallel_tim_sorter][is_stable]" )
+{
+    // Few different values make sure that equivalent elements
+    // end up in different chunks and cross slice boundaries
+
+    std::vector<int> values;
+    values.reserve(100'000);
+    auto distribution = dist::shuffled_16_values{};
+    distribution(std::back_inserter(values), 100'000);
+
+    std::vector<wrapper> collection;
+    collection.reserve(100'000);
+    for (std::size_t idx = 0 ; idx < values.size() ; ++idx) {
+        collection.push_back({values[idx], idx});
+    }
+
+    auto nb_threads = GENERATE(as<std::size_t>{}, 2, 3, 5, 8);
+    cppsort::sort(cppsort::parallel_tim_sorter(nb_threads), collection, &wrapper::value);
+    CHECK( std::is_sorted(std::begin(collection), std::end(collection)) );
+}
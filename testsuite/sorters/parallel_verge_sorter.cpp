@@ -0,0 +1,93 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <vector>
+#include <catch2/catch.hpp>
+#include <cpp-sort/sorters/parallel_verge_sorter.h>
+#include <cpp-sort/sort.h>
+#include "../distributions.h"
+
+TEST_CASE( "parallel_verge_sorter tests", "[parallel_verge_sorter]" )
+{
+    // The collections need to be big enough for the
+    // algorithm to actually split the work between
+    // several threads, the presorted distributions
+    // have runs crossing the boundaries of the chunks
+
+    std::vector<int> collection;
+    collection.reserve(100'000);
+    auto nb_threads = GENERATE(as<std::size_t>{}, 2, 3, 4, 7);
+    auto sorter = cppsort::parallel_verge_sorter(nb_threads);
+
+    SECTION( "shuffled distribution" )
+    {
+        auto distribution = dist::shuffled{};
+        distribution(std::back_inserter(collection), 100'000);
+        cppsort::sort(sorter, collection);
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection)) );
+    }
+
+    SECTION( "ascending distribution" )
+    {
+        auto distribution = dist::ascending{};
+        distribution(std::back_inserter(collection), 100'000);
+        cppsort::sort(sorter, collection);
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection)) );
+    }
+
+    SECTION( "descending distribution" )
+    {
+        auto distribution = dist::descending{};
+        distribution(std::back_inserter(collection), 100'000);
+        cppsort::sort(sorter, collection);
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection)) );
+    }
+
+    SECTION( "pipe_organ distribution" )
+    {
+        auto distribution = dist::pipe_organ{};
+        distribution(std::back_inserter(collection), 100'000);
+        cppsort::sort(sorter, collection);
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection)) );
+    }
+
+    SECTION( "ascending_sawtooth distribution with compare" )
+    {
+        auto distribution = dist::ascending_sawtooth{};
+        distribution(std::back_inserter(collection), 100'000);
+        cppsort::sort(sorter, collection, std::greater<>{});
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection), std::greater<>{}) );
+    }
+
+    SECTION( "push_middle distribution with projection" )
+    {
+        auto distribution = dist::push_middle{};
+        distribution(std::back_inserter(collection), 100'000);
+        cppsort::sort(sorter, collection, std::negate<>{});
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection), std::greater<>{}) );
+    }
+}
@@ -0,0 +1,88 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <random>
+#include <vector>
+#include <catch2/catch.hpp>
+#include <cpp-sort/sorters/pdq_sorter.h>
+
+namespace
+{
+    template<typename T, typename Compare>
+    auto test_pdq_sort(std::mt19937& engine, int size, int max_value)
+        -> void
+    {
+        std::uniform_int_distribution<int> distribution(-max_value, max_value);
+        std::vector<T> vec;
+        vec.reserve(size);
+        for (int i = 0 ; i < size ; ++i) {
+            vec.push_back(static_cast<T>(distribution(engine)));
+        }
+
+        auto expected = vec;
+        std::sort(std::begin(expected), std::end(expected), Compare{});
+
+        auto copy = vec;
+        cppsort::pdq_sort(vec, Compare{});
+        CHECK( vec == expected );
+
+        // Pointers take the same path as std::vector iterators
+        cppsort::pdq_sort(copy.data(), copy.data() + copy.size(), Compare{});
+        CHECK( copy == expected );
+    }
+
+    template<typename T, typename Compare>
+    auto test_pdq_sorts()
+        -> void
+    {
+        std::mt19937 engine(Catch::rngSeed());
+        // Sizes around the thresholds of the partitioning algorithms,
+        // few distinct values exercise the elements equal to the pivot
+        for (int size: { 25, 31, 63, 64, 65, 127, 128, 129, 255, 1000, 10'000 }) {
+            for (int max_value: { 0, 2, 100, 1'000'000 }) {
+                test_pdq_sort<T, Compare>(engine, size, max_value);
+            }
+        }
+    }
+}
+
+TEMPLATE_TEST_CASE( "pdq_sorter with arithmetic types", "[pdq_sorter]",
+                    std::int32_t, std::uint32_t, std::int64_t, std::uint64_t, float, double )
+{
+    // Vectorized partitioning is used for those types when
+    // the CPU supports it
+
+    SECTION( "std::less<>" )
+    {
+        test_pdq_sorts<TestType, std::less<>>();
+    }
+
+    SECTION( "std::greater<>" )
+    {
+        test_pdq_sorts<TestType, std::greater<>>();
+    }
+}
@@ -0,0 +1,176 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <random>
+#include <utility>
+#include <vector>
+#include <catch2/catch.hpp>
+#include <cpp-sort/fixed/sorting_network_sorter.h>
+
+namespace
+{
+    template<std::size_t N, typename T, typename Compare>
+    auto test_sorting_network(std::mt19937& engine)
+        -> void
+    {
+        // Small range of values to get duplicates, extreme
+        // values to make sure that they are not confused with
+        // the padding used by the vectorized algorithms
+        std::uniform_int_distribution<int> distribution(-20, 20);
+        std::array<T, N> collection;
+        for (auto& value: collection) {
+            value = static_cast<T>(distribution(engine));
+        }
+        if (N > 2) {
+            collection[0] = std::numeric_limits<T>::has_infinity ?
+                std::numeric_limits<T>::infinity() :
+                (std::numeric_limits<T>::max)();
+            collection[N / 2] = std::numeric_limits<T>::lowest();
+        }
+
+        auto expected = collection;
+        std::sort(std::begin(expected), std::end(expected), Compare{});
+
+        std::vector<T> vec(std::begin(collection), std::end(collection));
+        cppsort::sorting_network_sorter<N>{}(collection, Compare{});
+        CHECK( collection == expected );
+
+        cppsort::sorting_network_sorter<N>{}(vec, Compare{});
+        CHECK( std::equal(std::begin(vec), std::end(vec), std::begin(expected)) );
+    }
+
+    template<typename T, typename Compare, std::size_t... Indices>
+    auto test_sorting_networks(std::index_sequence<Indices...>)
+        -> void
+    {
+        std::mt19937 engine(Catch::rngSeed());
+        for (int i = 0 ; i < 20 ; ++i) {
+            (void) std::initializer_list<int>{
+                (test_sorting_network<Indices, T, Compare>(engine), 0)...
+            };
+        }
+    }
+}
+
+TEMPLATE_TEST_CASE( "sorting_network_sorter with arithmetic types", "[sorting_network_sorter]",
+                    std::int32_t, std::int64_t, float, double )
+{
+    // The vectorized networks are used for some of those types,
+    // sizes and comparisons when the CPU supports it
+
+    auto sizes = std::make_index_sequence<33>{};
+
+    SECTION( "std::less<>" )
+    {
+        test_sorting_networks<TestType, std::less<>>(sizes);
+    }
+
+    SECTION( "std::greater<>" )
+    {
+        test_sorting_networks<TestType, std::greater<>>(sizes);
+    }
+}
+
+TEST_CASE( "sorting_network_sorter with signed zeros and NaN", "[sorting_network_sorter]" )
+{
+    // The vectorized min and max instructions return their second
+    // operand when comparing ±0 or NaN, make sure that the networks
+    // don't duplicate or lose such values
+
+    std::mt19937 engine(Catch::rngSeed());
+    std::uniform_int_distribution<int> distribution(0, 7);
+
+    auto check_values = [&](auto&& collection, auto sorter) {
+        using value_type = std::decay_t<decltype(collection[0])>;
+        for (int i = 0 ; i < 100 ; ++i) {
+            for (auto& value: collection) {
+                switch (distribution(engine)) {
+                    case 0:  value = value_type(-0.0); break;
+                    case 1:  value = value_type(0.0); break;
+                    case 2:  value = std::numeric_limits<value_type>::quiet_NaN(); break;
+                    default: value = value_type(distribution(engine) - 4); break;
+                }
+            }
+
+            auto count = [&](auto pred) {
+                return std::count_if(std::begin(collection), std::end(collection), pred);
+            };
+            auto is_nan = [](value_type value) { return std::isnan(value); };
+            auto is_negative_zero = [](value_type value) { return value == 0 && std::signbit(value); };
+            auto is_positive_zero = [](value_type value) { return value == 0 && not std::signbit(value); };
+            auto nb_nan = count(is_nan);
+            auto nb_negative_zeros = count(is_negative_zero);
+            auto nb_positive_zeros = count(is_positive_zero);
+
+            std::vector<value_type> others;
+            for (auto value: collection) {
+                if (not std::isnan(value) && value != 0) {
+                    others.push_back(value);
+                }
+            }
+            std::sort(std::begin(others), std::end(others));
+
+            sorter(collection);
+            CHECK( count(is_nan) == nb_nan );
+            CHECK( count(is_negative_zero) == nb_negative_zeros );
+            CHECK( count(is_positive_zero) == nb_positive_zeros );
+
+            std::vector<value_type> sorted_others;
+            for (auto value: collection) {
+                if (not std::isnan(value) && value != 0) {
+                    sorted_others.push_back(value);
+                }
+            }
+            // NaN breaks the ordering, only check that the values are kept
+            std::sort(std::begin(sorted_others), std::end(sorted_others));
+            CHECK( sorted_others == others );
+        }
+    };
+
+    SECTION( "N=16" )
+    {
+        std::array<float, 16> collection;
+        check_values(collection, cppsort::sorting_network_sorter<16>{});
+        check_values(collection, [](auto& arr) {
+            cppsort::sorting_network_sorter<16>{}(arr, std::greater<>{});
+        });
+    }
+
+    SECTION( "N=32" )
+    {
+        std::array<float, 32> collection;
+        check_values(collection, cppsort::sorting_network_sorter<32>{});
+        check_values(collection, [](auto& arr) {
+            cppsort::sorting_network_sorter<32>{}(arr, std::greater<>{});
+        });
+    }
+}
@@ -0,0 +1,130 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <vector>
+#include <catch2/catch.hpp>
+#include <cpp-sort/adapters/indirect_adapter.h>
+#include <cpp-sort/adapters/schwartz_adapter.h>
+#include <cpp-sort/probes/inv.h>
+#include <cpp-sort/probes/max.h>
+#include <cpp-sort/sorters/merge_sorter.h>
+#include <cpp-sort/sorters/pdq_sorter.h>
+#include <cpp-sort/sorters/spin_sorter.h>
+#include <cpp-sort/sorters/tim_sorter.h>
+#include <cpp-sort/utility/memory_resource.h>
+#include "../distributions.h"
+
+namespace
+{
+    // Forwards to ::operator new and keeps track of the
+    // memory currently allocated through it
+    class counting_resource:
+        public cppsort::utility::memory_resource
+    {
+        public:
+
+            std::size_t nb_allocations = 0;
+            std::size_t allocated = 0;
+
+        private:
+
+            auto do_allocate(std::size_t bytes, std::size_t)
+                -> void* override
+            {
+                ++nb_allocations;
+                allocated += bytes;
+                return ::operator new(bytes);
+            }
+
+            auto do_deallocate(void* pointer, std::size_t bytes, std::size_t)
+                -> void override
+            {
+                allocated -= bytes;
+                ::operator delete(pointer);
+            }
+    };
+}
+
+TEST_CASE( "memory resources used by the buffered algorithms",
+           "[utility][memory_resource]" )
+{
+    std::vector<int> collection;
+    collection.reserve(10'000);
+    auto distribution = dist::shuffled{};
+    distribution(std::back_inserter(collection), 10'000);
+
+    SECTION( "every allocation goes through the resource" )
+    {
+        counting_resource resource;
+        {
+            cppsort::utility::scoped_memory_resource _(&resource);
+            CHECK( cppsort::utility::scoped_memory_resource::current() == &resource );
+
+            auto copy1 = collection;
+            cppsort::merge_sort(copy1);
+            CHECK( std::is_sorted(copy1.begin(), copy1.end()) );
+            auto copy2 = collection;
+            cppsort::tim_sort(copy2);
+            CHECK( std::is_sorted(copy2.begin(), copy2.end()) );
+            auto copy3 = collection;
+            cppsort::spin_sort(copy3);
+            CHECK( std::is_sorted(copy3.begin(), copy3.end()) );
+            auto copy4 = collection;
+            cppsort::schwartz_adapter<cppsort::pdq_sorter>{}(copy4, std::negate<>{});
+            CHECK( std::is_sorted(copy4.begin(), copy4.end(), std::greater<>{}) );
+            auto copy5 = collection;
+            cppsort::indirect_adapter<cppsort::pdq_sorter>{}(copy5);
+            CHECK( std::is_sorted(copy5.begin(), copy5.end()) );
+            CHECK( cppsort::probe::inv(copy5) == 0 );
+            CHECK( cppsort::probe::inv(collection) > 0 );
+            CHECK( cppsort::probe::max(copy5) == 0 );
+        }
+        CHECK( cppsort::utility::scoped_memory_resource::current() == nullptr );
+        CHECK( resource.nb_allocations >= 8 );
+        CHECK( resource.allocated == 0 );
+    }
+
+    SECTION( "monotonic_buffer_resource reaches a steady state" )
+    {
+        cppsort::utility::monotonic_buffer_resource arena;
+        cppsort::utility::scoped_memory_resource _(&arena);
+
+        std::size_t capacity = 0;
+        for (int idx = 0 ; idx < 5 ; ++idx) {
+            auto copy = collection;
+            cppsort::merge_sort(copy);
+            CHECK( std::is_sorted(copy.begin(), copy.end()) );
+            arena.release();
+            if (idx > 0) {
+                // No new block once the arena was released once
+                CHECK( arena.capacity() == capacity );
+            }
+            capacity = arena.capacity();
+        }
+        CHECK( capacity > 0 );
+    }
+}
@@ -0,0 +1,164 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <numeric>
+#include <string>
+#include <vector>
+#include <catch2/catch.hpp>
+#include <cpp-sort/sorters/lsd_radix_sorter.h>
+#include <cpp-sort/sorters/merge_sorter.h>
+#include <cpp-sort/sorters/pdq_sorter.h>
+#include <cpp-sort/sorters/ska_sorter.h>
+#include <cpp-sort/sorters/spread_sorter.h>
+#include <cpp-sort/utility/iter_move.h>
+#include <cpp-sort/utility/zip_iterator.h>
+#include "../distributions.h"
+
+namespace
+{
+    // A table stored column-wise: every row has a unique id and a
+    // name derived from that id, which makes it possible to check
+    // that the columns were permuted together
+    struct table
+    {
+        std::vector<int> keys;
+        std::vector<std::string> names;
+        std::vector<long long> ids;
+
+        explicit table(std::size_t size)
+        {
+            auto distribution = dist::shuffled{};
+            distribution(std::back_inserter(keys), size, 0);
+            for (auto& key: keys) {
+                key %= 64;
+            }
+            for (std::size_t i = 0 ; i < size ; ++i) {
+                ids.push_back(static_cast<long long>(i));
+                names.push_back("row " + std::to_string(i));
+            }
+        }
+
+        auto rows_are_consistent() const
+            -> bool
+        {
+            auto sorted_ids = ids;
+            std::sort(sorted_ids.begin(), sorted_ids.end());
+            for (std::size_t i = 0 ; i < ids.size() ; ++i) {
+                if (sorted_ids[i] != static_cast<long long>(i)) return false;
+                if (names[i] != "row " + std::to_string(ids[i])) return false;
+            }
+            return true;
+        }
+
+        auto is_stable_on_keys() const
+            -> bool
+        {
+            for (std::size_t i = 1 ; i < keys.size() ; ++i) {
+                if (keys[i - 1] == keys[i] && ids[i - 1] > ids[i]) return false;
+            }
+            return true;
+        }
+    };
+}
+
+TEST_CASE( "sort several sequences with zip_iterator",
+           "[utility][zip_iterator]" )
+{
+    table tab(2500);
+    auto rows = cppsort::utility::zip(tab.keys, tab.names, tab.ids);
+
+    SECTION( "iter_move and iter_swap" )
+    {
+        auto first = rows.begin();
+        auto second = std::next(first);
+        auto key0 = tab.keys[0];
+        auto key1 = tab.keys[1];
+
+        using cppsort::utility::iter_swap;
+        iter_swap(first, second);
+        CHECK( tab.keys[0] == key1 );
+        CHECK( tab.keys[1] == key0 );
+        CHECK( tab.names[0] == "row 1" );
+        CHECK( tab.names[1] == "row 0" );
+
+        using cppsort::utility::iter_move;
+        auto tmp = iter_move(first);
+        *first = iter_move(second);
+        *second = std::move(tmp);
+        CHECK( tab.keys[0] == key0 );
+        CHECK( tab.names[0] == "row 0" );
+        CHECK( tab.ids[1] == 1 );
+        CHECK( std::distance(rows.begin(), rows.end()) == 2500 );
+    }
+
+    SECTION( "comparison sorters" )
+    {
+        cppsort::pdq_sort(rows, std::greater<>{}, cppsort::utility::zip_get<1>{});
+        CHECK( std::is_sorted(tab.names.begin(), tab.names.end(), std::greater<>{}) );
+        CHECK( tab.rows_are_consistent() );
+
+        cppsort::merge_sort(rows, cppsort::utility::zip_get<0>{});
+        CHECK( std::is_sorted(tab.keys.begin(), tab.keys.end()) );
+        CHECK( tab.rows_are_consistent() );
+
+        // Restore the order of the ids, then check stability
+        cppsort::pdq_sort(rows, cppsort::utility::zip_get<2>{});
+        cppsort::merge_sort(rows, cppsort::utility::zip_get<0>{});
+        CHECK( tab.is_stable_on_keys() );
+    }
+
+    SECTION( "radix sorters" )
+    {
+        cppsort::ska_sort(rows, cppsort::utility::zip_get<0>{});
+        CHECK( std::is_sorted(tab.keys.begin(), tab.keys.end()) );
+        CHECK( tab.rows_are_consistent() );
+
+        cppsort::ska_sort(rows, cppsort::utility::zip_get<1>{});
+        CHECK( std::is_sorted(tab.names.begin(), tab.names.end()) );
+        CHECK( tab.rows_are_consistent() );
+
+        cppsort::spread_sort(rows, cppsort::utility::zip_get<0>{});
+        CHECK( std::is_sorted(tab.keys.begin(), tab.keys.end()) );
+        CHECK( tab.rows_are_consistent() );
+
+        cppsort::ska_sort(rows, cppsort::utility::zip_get<2>{});
+        cppsort::lsd_radix_sort(rows, cppsort::utility::zip_get<0>{});
+        CHECK( std::is_sorted(tab.keys.begin(), tab.keys.end()) );
+        CHECK( tab.rows_are_consistent() );
+        CHECK( tab.is_stable_on_keys() );
+    }
+
+    SECTION( "longer columns" )
+    {
+        // Only the rows of the first column are sorted
+        std::vector<int> keys = { 3, 1, 2 };
+        std::vector<int> values = { 30, 10, 20, 0, -1 };
+        cppsort::ska_sort(cppsort::utility::zip(keys, values), cppsort::utility::zip_get<0>{});
+        CHECK( keys == std::vector<int>{ 1, 2, 3 } );
+        CHECK( values == std::vector<int>{ 10, 20, 30, 0, -1 } );
+    }
+}